@@ -0,0 +1,84 @@
+import slicer
+from slicer import (
+    vtkMRMLAbstractViewNode,
+    vtkMRMLLayerDisplayableManager,
+    vtkMRMLLayerDMInteractionRecorder,
+)
+
+
+def getLayerDisplayableManager(view) -> vtkMRMLLayerDisplayableManager | None:
+    """
+    Returns the layer displayable manager of the input view.
+
+    The view can be the layer displayable manager itself, a view widget providing displayableManagerByClassName
+    (qMRMLThreeDView, qMRMLSliceView, ...) or a view node. View nodes are resolved using the application layout manager
+    and are only supported when Slicer is started with its main window.
+    """
+    if isinstance(view, vtkMRMLLayerDisplayableManager):
+        return view
+
+    if isinstance(view, vtkMRMLAbstractViewNode):
+        layoutManager = slicer.app.layoutManager()
+        if layoutManager is None:
+            raise RuntimeError(
+                "View nodes cannot be resolved without the layout manager. "
+                "Pass the view widget or the layer displayable manager instead."
+            )
+        viewWidget = layoutManager.viewWidget(view)
+        if viewWidget is None:
+            return None
+        view = viewWidget.viewWidget()
+
+    return view.displayableManagerByClassName(vtkMRMLLayerDisplayableManager.__name__)
+
+
+def _requireLayerDisplayableManager(view) -> vtkMRMLLayerDisplayableManager:
+    displayableManager = getLayerDisplayableManager(view)
+    if displayableManager is None:
+        raise ValueError(f"No layer displayable manager found for view {view}")
+    return displayableManager
+
+
+def startInteractionRecording(view, recordingPath: str) -> vtkMRMLLayerDMInteractionRecorder:
+    """
+    Record the interactions of the input view to the recording path until the returned recorder's StopRecording is
+    called. See getLayerDisplayableManager for the supported view types.
+    """
+    pipelineManager = _requireLayerDisplayableManager(view).GetPipelineManager()
+    recorder = vtkMRMLLayerDMInteractionRecorder()
+    if not recorder.StartRecording(recordingPath):
+        raise OSError(f"Failed to start interaction recording to {recordingPath}")
+    pipelineManager.SetInteractionRecorder(recorder)
+    return recorder
+
+
+def replayInteractions(recordingPath: str, view, scenePath: str | None = None) -> dict:
+    """
+    Replay the recorded interactions against the input view and report the per event latencies in ms.
+    See getLayerDisplayableManager for the supported view types. The replayed events are attached to the renderer of
+    the view's layer displayable manager.
+    If a scene path is provided, the scene is loaded before the replay.
+
+    Can be used with Slicer started with --no-main-window for offscreen benchmarks by passing the view widget or the
+    layer displayable manager of an offscreen view.
+    """
+    displayableManager = _requireLayerDisplayableManager(view)
+    if scenePath is not None:
+        slicer.util.loadScene(scenePath)
+
+    # Make sure the pipelines are up to date with the scene before replaying
+    slicer.app.processEvents()
+
+    pipelineManager = displayableManager.GetPipelineManager()
+    recorder = vtkMRMLLayerDMInteractionRecorder()
+    if not recorder.Replay(recordingPath, pipelineManager, displayableManager.GetRenderer()):
+        raise OSError(f"Failed to replay interaction recording {recordingPath}")
+
+    return {
+        "events": recorder.GetNumberOfReplayedEvents(),
+        "canProcessP50": recorder.GetCanProcessLatencyPercentile(50),
+        "canProcessP99": recorder.GetCanProcessLatencyPercentile(99),
+        "processP50": recorder.GetProcessLatencyPercentile(50),
+        "processP99": recorder.GetProcessLatencyPercentile(99),
+        "focusChanges": recorder.GetNumberOfFocusChanges(),
+    }
@@ -0,0 +1,60 @@
+import numpy as np
+from slicer import vtkMRMLLayerDMScriptedPipelineBridge
+from vtk import vtkDataArray, vtkPoints
+from vtk.util.numpy_support import create_vtk_array, get_vtk_array_type
+
+
+def _asWritableContiguous(values: np.ndarray) -> np.ndarray:
+    """
+    Returns the input array if it is writable and C-contiguous, and a contiguous copy otherwise.
+    """
+    values = np.ascontiguousarray(values)
+    return values if values.flags.writeable else values.copy()
+
+
+def setArrayFromNumpy(values: np.ndarray, array: vtkDataArray | None = None) -> vtkDataArray:
+    """
+    Use the input NumPy array as the storage of the VTK array without copying it.
+
+    If array is None, a new VTK array matching the NumPy dtype is created. 2D inputs are interpreted as
+    (nTuples, nComponents). Non C-contiguous or read-only inputs are copied once to a writable contiguous array.
+
+    The NumPy buffer is kept alive by the VTK array until the array is deleted or its storage is replaced. In place
+    modifications of the NumPy array are visible in VTK after calling markModified on the array.
+    """
+    values = _asWritableContiguous(values)
+    if array is None:
+        array = create_vtk_array(get_vtk_array_type(values.dtype))
+
+    nComponents = values.shape[1] if values.ndim == 2 else 1
+    if not vtkMRMLLayerDMScriptedPipelineBridge.SetArrayFromPythonBuffer(array, values, nComponents):
+        raise TypeError(f"Failed to use {values.dtype} array of shape {values.shape} as {array.GetClassName()} storage.")
+    return array
+
+
+def setPointsFromNumpy(values: np.ndarray, points: vtkPoints | None = None) -> vtkPoints:
+    """
+    Use the input (N, 3) NumPy array as the storage of the VTK points without copying it.
+    Inputs which are not float32 or float64 are converted to float64 once.
+    """
+    values = np.asarray(values)
+    if values.ndim != 2 or values.shape[1] != 3:
+        raise ValueError(f"Expected (N, 3) points array. Got {values.shape}.")
+
+    if values.dtype not in (np.float32, np.float64):
+        values = values.astype(np.float64)
+    values = _asWritableContiguous(values)
+
+    points = points if points is not None else vtkPoints()
+    if not vtkMRMLLayerDMScriptedPipelineBridge.SetPointsFromPythonBuffer(points, values):
+        raise TypeError(f"Failed to use {values.dtype} array of shape {values.shape} as points storage.")
+    return points
+
+
+def markModified(*objects: vtkDataArray | vtkPoints) -> None:
+    """
+    Signal that the NumPy buffers of the input arrays / points were modified in place.
+    Only the modified arrays are uploaded again by the mappers on next render.
+    """
+    for obj in objects:
+        obj.Modified()
@@ -5,6 +5,7 @@ from slicer import (
     vtkMRMLAbstractWidget,
     vtkMRMLInteractionEventData,
     vtkMRMLLayerDMPipelineManager,
+    vtkMRMLLayerDMRenderContext,
     vtkMRMLLayerDMScriptedPipelineBridge,
     vtkMRMLNode,
     vtkMRMLScene,
@@ -12,7 +13,26 @@ from slicer import (
 from vtk import vtkCamera, vtkRenderer, vtkObject
 
 
+def layerDMDefault(func):
+    """
+    Flag the decorated method as a default implementation.
+    Default implementations are not called by vtkMRMLLayerDMScriptedPipelineBridge which uses its C++ implementation
+    instead, avoiding the GIL acquisition and python call overhead for methods not overridden by the pipelines.
+    """
+    func._layerDMDefault = True
+    return func
+
+
 class vtkMRMLLayerDMScriptedPipeline(vtkMRMLLayerDMScriptedPipelineBridge):
+    """
+    Python base class for the layered displayable manager pipelines.
+
+    Pipelines with a fixed render layer or camera should declare them in their constructor using
+    SetStaticRenderLayer / SetStaticCamera instead of overriding GetRenderLayer / GetCamera.
+    Declared values are cached in C++ and don't require Python calls when queried by the layer manager and the
+    interaction logic.
+    """
+
     def __init__(self):
         self.SetPythonObject(self)
 
@@ -24,52 +44,122 @@ class vtkMRMLLayerDMScriptedPipeline(vtkMRMLLayerDMScriptedPipelineBridge):
     def displayNode(self) -> vtkMRMLNode:
         return self.GetDisplayNode()
 
+    def getProfilingCounters(self) -> dict[str, dict[str, float]]:
+        """
+        Returns the profiling counters of the python methods called since the last ResetProfilingCounters.
+        Profiling needs to be enabled first using SetProfilingEnabled(True). Times are in ms.
+        """
+        return {
+            name: {
+                "callCount": self.GetProfilingCallCount(name),
+                "totalTime": self.GetProfilingTotalTime(name),
+                "maxTime": self.GetProfilingMaxTime(name),
+                "gilAcquisitionCount": self.GetProfilingGilAcquisitionCount(name),
+                "gilWaitTime": self.GetProfilingGilWaitTime(name),
+            }
+            for name in self.GetProfiledMethodNames()
+        }
+
+    @layerDMDefault
+    def ApplyUpdate(self, result: Any) -> None:
+        """
+        Apply the result returned by the last completed ComputeUpdateAsync call on the main thread.
+        A render is requested by the pipeline manager once the update is applied.
+        """
+        pass
+
+    @layerDMDefault
     def CanProcessInteractionEvent(self, eventData: vtkMRMLInteractionEventData) -> tuple[bool, float]:
         import sys
 
         return False, sys.float_info.max
 
+    @layerDMDefault
+    def ComputeUpdateAsync(self) -> Any:
+        """
+        Compute the expensive part of the pipeline update on a worker thread and return its result.
+        Overriding this method makes the pipeline update asynchronous: it is scheduled after each UpdatePipeline call
+        and its result is forwarded to ApplyUpdate on the main thread.
+
+        Rendered VTK objects, nodes and scene must not be modified. Long computations should regularly check
+        IsAsyncUpdateCancelled() and return early when the update has been superseded by a new request.
+        If an exception is raised, the update is reported as failed and ApplyUpdate is not called.
+        """
+        return None
+
+    @layerDMDefault
     def GetCamera(self) -> vtkCamera | None:
         return None
 
+    @layerDMDefault
     def GetMouseCursor(self) -> int:
         return 0
 
+    @layerDMDefault
     def GetRenderLayer(self) -> int:
         return 0
 
+    @layerDMDefault
     def GetWidgetState(self) -> int:
         return vtkMRMLAbstractWidget.WidgetStateIdle
 
+    @layerDMDefault
     def LoseFocus(self, eventData: vtkMRMLInteractionEventData) -> None:
         pass
 
+    @layerDMDefault
+    def OnBeforeRender(self, context: vtkMRMLLayerDMRenderContext) -> None:
+        """
+        Called once per frame before rendering when the view components selected by SetViewDependencyMask changed
+        since the previous frame or when requested using RequestBeforeRender.
+        """
+        pass
+
+    @layerDMDefault
+    def OnDefaultCameraChanged(self, camera: vtkCamera, cameraChanges: int) -> None:
+        """
+        Called when the default camera components selected by SetDefaultCameraChangeMask are modified.
+        cameraChanges is a bit mask of the vtkMRMLLayerDMPipelineI.CameraChange flags.
+        Calls OnDefaultCameraModified when not overridden.
+        """
+        self.OnDefaultCameraModified(camera)
+
+    @layerDMDefault
     def OnDefaultCameraModified(self, camera: vtkCamera) -> None:
         pass
 
+    @layerDMDefault
     def OnRendererAdded(self, renderer: vtkRenderer) -> None:
         pass
 
+    @layerDMDefault
     def OnRendererRemoved(self, renderer: vtkRenderer) -> None:
         pass
 
+    @layerDMDefault
     def OnUpdate(self, obj: vtkObject, eventId: int, callData: Any) -> None:
         pass
 
+    @layerDMDefault
     def ProcessInteractionEvent(self, eventData: vtkMRMLInteractionEventData) -> bool:
         return False
 
+    @layerDMDefault
     def SetDisplayNode(self, displayNode: vtkMRMLNode) -> None:
         pass
 
+    @layerDMDefault
     def SetViewNode(self, viewNode: vtkMRMLAbstractViewNode) -> None:
         pass
 
+    @layerDMDefault
     def SetScene(self, scene: vtkMRMLScene) -> None:
         pass
 
+    @layerDMDefault
     def SetPipelineManager(self, pipelineManager: vtkMRMLLayerDMPipelineManager) -> None:
         pass
 
+    @layerDMDefault
     def UpdatePipeline(self) -> None:
         pass
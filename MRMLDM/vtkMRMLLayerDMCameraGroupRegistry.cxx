@@ -0,0 +1,170 @@
+#include "vtkMRMLLayerDMCameraGroupRegistry.h"
+
+#include "vtkMRMLLayerDMLayerManager.h"
+#include "vtkMRMLLayerDMPipelineManager.h"
+
+#include <vtkBoundingBox.h>
+#include <vtkCamera.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkMRMLLayerDMCameraGroupRegistry);
+
+vtkSmartPointer<vtkMRMLLayerDMCameraGroupRegistry> vtkMRMLLayerDMCameraGroupRegistry::GetInstance()
+{
+  static vtkSmartPointer<vtkMRMLLayerDMCameraGroupRegistry> instance = vtkSmartPointer<vtkMRMLLayerDMCameraGroupRegistry>::New();
+  return instance;
+}
+
+vtkMRMLLayerDMCameraGroupRegistry::vtkMRMLLayerDMCameraGroupRegistry()
+  : m_groups{}
+  , m_isUpdatingClippingRange{ false }
+{
+}
+
+bool vtkMRMLLayerDMCameraGroupRegistry::Join(const std::string& groupName, vtkMRMLLayerDMPipelineManager* pipelineManager)
+{
+  if (!pipelineManager || groupName.empty())
+  {
+    return false;
+  }
+
+  Leave(pipelineManager);
+  auto& group = m_groups[groupName];
+  if (!group.Camera)
+  {
+    group.Camera = vtkSmartPointer<vtkCamera>::New();
+  }
+  group.Members.emplace_back(pipelineManager);
+  group.IsClippingRangeOutdated = true;
+  Modified();
+  return true;
+}
+
+void vtkMRMLLayerDMCameraGroupRegistry::Leave(vtkMRMLLayerDMPipelineManager* pipelineManager)
+{
+  bool isRemoved = false;
+  for (auto it = m_groups.begin(); it != m_groups.end();)
+  {
+    // Members deleted without leaving their group are removed as well
+    auto& members = it->second.Members;
+    auto nMembers = members.size();
+    members.erase(std::remove_if(members.begin(),
+                                 members.end(),
+                                 [pipelineManager](const vtkWeakPointer<vtkMRMLLayerDMPipelineManager>& member)
+                                 { return !member || member == pipelineManager; }),
+                  members.end());
+    isRemoved |= (members.size() != nMembers);
+    it = members.empty() ? m_groups.erase(it) : std::next(it);
+  }
+
+  if (isRemoved)
+  {
+    Modified();
+  }
+}
+
+vtkCamera* vtkMRMLLayerDMCameraGroupRegistry::GetGroupCamera(const std::string& groupName) const
+{
+  auto group = FindGroup(groupName);
+  return group ? group->Camera.GetPointer() : nullptr;
+}
+
+vtkMRMLLayerDMPipelineManager* vtkMRMLLayerDMCameraGroupRegistry::GetGroupSynchronizer(const std::string& groupName) const
+{
+  auto group = FindGroup(groupName);
+  if (!group)
+  {
+    return nullptr;
+  }
+
+  auto synchronizer = std::find_if(group->Members.begin(), group->Members.end(), [](const auto& member) { return member != nullptr; });
+  return synchronizer != group->Members.end() ? synchronizer->GetPointer() : nullptr;
+}
+
+int vtkMRMLLayerDMCameraGroupRegistry::GetNumberOfGroups() const
+{
+  return static_cast<int>(m_groups.size());
+}
+
+int vtkMRMLLayerDMCameraGroupRegistry::GetNumberOfMembers(const std::string& groupName) const
+{
+  // Members deleted without leaving their group are not counted
+  auto group = FindGroup(groupName);
+  return group ? static_cast<int>(std::count_if(group->Members.begin(), group->Members.end(), [](const auto& member) { return member != nullptr; })) : 0;
+}
+
+void vtkMRMLLayerDMCameraGroupRegistry::RequestClippingRangeUpdate(const std::string& groupName)
+{
+  // Setting the clipping range modifies the group camera which requests a new update from the views
+  if (m_isUpdatingClippingRange)
+  {
+    return;
+  }
+
+  auto found = m_groups.find(groupName);
+  if (found != m_groups.end())
+  {
+    found->second.IsClippingRangeOutdated = true;
+  }
+}
+
+bool vtkMRMLLayerDMCameraGroupRegistry::UpdateClippingRange(const std::string& groupName)
+{
+  auto found = m_groups.find(groupName);
+  if (found == m_groups.end() || !found->second.IsClippingRangeOutdated)
+  {
+    return false;
+  }
+
+  auto& group = found->second;
+  group.IsClippingRangeOutdated = false;
+  ++group.NumberOfClippingRangeUpdates;
+
+  // Union of the visible bounds of the layers rendered with the group camera in all the views
+  vtkBoundingBox bbox;
+  for (const auto& member : group.Members)
+  {
+    if (member)
+    {
+      double bounds[6];
+      member->m_layerManager->ComputeDefaultCameraVisibleBounds(bounds);
+      if (vtkMath::AreBoundsInitialized(bounds))
+      {
+        bbox.AddBounds(bounds);
+      }
+    }
+  }
+
+  if (!bbox.IsValid())
+  {
+    return true;
+  }
+
+  double bounds[6];
+  bbox.GetBounds(bounds);
+  m_isUpdatingClippingRange = true;
+  for (const auto& member : group.Members)
+  {
+    if (member && member->m_layerManager->ResetDefaultCameraClippingRange(bounds))
+    {
+      break;
+    }
+  }
+  m_isUpdatingClippingRange = false;
+  return true;
+}
+
+int vtkMRMLLayerDMCameraGroupRegistry::GetNumberOfClippingRangeUpdates(const std::string& groupName) const
+{
+  auto group = FindGroup(groupName);
+  return group ? group->NumberOfClippingRangeUpdates : 0;
+}
+
+const vtkMRMLLayerDMCameraGroupRegistry::CameraGroup* vtkMRMLLayerDMCameraGroupRegistry::FindGroup(const std::string& groupName) const
+{
+  auto found = m_groups.find(groupName);
+  return found != m_groups.end() ? &found->second : nullptr;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+class vtkCamera;
+class vtkMRMLLayerDMPipelineManager;
+
+/// \brief Registry of the camera groups shared by linked views.
+///
+/// The pipeline managers of views sharing a camera link join the same group using
+/// \sa vtkMRMLLayerDMPipelineManager::SetCameraGroup. The views of a group share a single default camera:
+/// - The camera is synchronized once, by the camera synchronizer of the first view of the group. The other views read
+///   the shared camera.
+/// - The clipping range of the shared camera is computed once per frame from the visible bounds of the layers of all
+///   the views of the group, by the first view starting its render after a clipping range update was requested.
+///
+/// ModifiedEvent is invoked when the members of a group change so that the views can update their default camera.
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMCameraGroupRegistry : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMCameraGroupRegistry* New();
+  vtkTypeMacro(vtkMRMLLayerDMCameraGroupRegistry, vtkObject);
+
+  /// \brief Singleton instance of the registry shared by the pipeline managers
+  static vtkSmartPointer<vtkMRMLLayerDMCameraGroupRegistry> GetInstance();
+
+  /// Add the pipeline manager to the input group, creating the group if needed.
+  /// The manager is removed from its previous group.
+  /// \return false if the manager is nullptr or the group name is empty.
+  bool Join(const std::string& groupName, vtkMRMLLayerDMPipelineManager* pipelineManager);
+
+  /// Remove the pipeline manager from its group. Groups without members are deleted.
+  void Leave(vtkMRMLLayerDMPipelineManager* pipelineManager);
+
+  /// Returns the camera shared by the views of the group. nullptr if the group doesn't exist.
+  vtkCamera* GetGroupCamera(const std::string& groupName) const;
+
+  /// Returns the pipeline manager synchronizing the camera of the group (first member).
+  vtkMRMLLayerDMPipelineManager* GetGroupSynchronizer(const std::string& groupName) const;
+
+  /// Number of existing groups.
+  int GetNumberOfGroups() const;
+
+  /// Number of live pipeline managers in the group.
+  int GetNumberOfMembers(const std::string& groupName) const;
+
+  /// Mark the clipping range of the group camera as outdated.
+  /// Requests made while the clipping range is being updated are ignored.
+  void RequestClippingRangeUpdate(const std::string& groupName);
+
+  /// Compute the clipping range of the group camera if an update was requested since the previous update.
+  /// Called by the views of the group before rendering.
+  /// \return true if the clipping range was computed.
+  bool UpdateClippingRange(const std::string& groupName);
+
+  /// Number of clipping range computations of the group since its creation.
+  int GetNumberOfClippingRangeUpdates(const std::string& groupName) const;
+
+protected:
+  vtkMRMLLayerDMCameraGroupRegistry();
+  ~vtkMRMLLayerDMCameraGroupRegistry() override = default;
+
+private:
+  struct CameraGroup
+  {
+    vtkSmartPointer<vtkCamera> Camera;
+    std::vector<vtkWeakPointer<vtkMRMLLayerDMPipelineManager>> Members;
+    bool IsClippingRangeOutdated{ true };
+    int NumberOfClippingRangeUpdates{ 0 };
+  };
+
+  const CameraGroup* FindGroup(const std::string& groupName) const;
+
+  std::map<std::string, CameraGroup> m_groups;
+  bool m_isUpdatingClippingRange;
+};
@@ -8,7 +8,133 @@
 #include <vtkCamera.h>
 #include <vtkRenderer.h>
 #include <vtkMatrix4x4.h>
+#include <algorithm>
 #include <array>
+#include <functional>
+
+namespace
+{
+/// Copy the view parameters of the source camera which differ from the target camera.
+/// Covers the parameters copied by vtkCamera::DeepCopy, except the clipping range and thickness which are reset on the
+/// target camera depending on the layer bounds.
+/// \return true if any parameter was copied.
+bool CopyChangedViewParameters(vtkCamera* source, vtkCamera* target)
+{
+  auto isEqual = [](const double* a, const double* b, int size) { return std::equal(a, a + size, b); };
+  auto isMatrixEqual = [&isEqual](vtkMatrix4x4* a, vtkMatrix4x4* b) { return isEqual(a->GetData(), b->GetData(), 16); };
+
+  bool isChanged = false;
+  if (!isEqual(source->GetPosition(), target->GetPosition(), 3))
+  {
+    target->SetPosition(source->GetPosition());
+    isChanged = true;
+  }
+  if (!isEqual(source->GetFocalPoint(), target->GetFocalPoint(), 3))
+  {
+    target->SetFocalPoint(source->GetFocalPoint());
+    isChanged = true;
+  }
+  if (!isEqual(source->GetViewUp(), target->GetViewUp(), 3))
+  {
+    target->SetViewUp(source->GetViewUp());
+    isChanged = true;
+  }
+  if (!isEqual(source->GetWindowCenter(), target->GetWindowCenter(), 2))
+  {
+    target->SetWindowCenter(source->GetWindowCenter()[0], source->GetWindowCenter()[1]);
+    isChanged = true;
+  }
+  if (source->GetViewAngle() != target->GetViewAngle())
+  {
+    target->SetViewAngle(source->GetViewAngle());
+    isChanged = true;
+  }
+  if (source->GetParallelScale() != target->GetParallelScale())
+  {
+    target->SetParallelScale(source->GetParallelScale());
+    isChanged = true;
+  }
+  if (source->GetParallelProjection() != target->GetParallelProjection())
+  {
+    target->SetParallelProjection(source->GetParallelProjection());
+    isChanged = true;
+  }
+  if (source->GetUseHorizontalViewAngle() != target->GetUseHorizontalViewAngle())
+  {
+    target->SetUseHorizontalViewAngle(source->GetUseHorizontalViewAngle());
+    isChanged = true;
+  }
+  if (!isEqual(source->GetViewShear(), target->GetViewShear(), 3))
+  {
+    target->SetViewShear(source->GetViewShear());
+    isChanged = true;
+  }
+
+  // Stereo and off-axis projection
+  if (source->GetEyeAngle() != target->GetEyeAngle())
+  {
+    target->SetEyeAngle(source->GetEyeAngle());
+    isChanged = true;
+  }
+  if (source->GetEyeSeparation() != target->GetEyeSeparation())
+  {
+    target->SetEyeSeparation(source->GetEyeSeparation());
+    isChanged = true;
+  }
+  if (source->GetLeftEye() != target->GetLeftEye())
+  {
+    target->SetLeftEye(source->GetLeftEye());
+    isChanged = true;
+  }
+  if (source->GetFocalDisk() != target->GetFocalDisk())
+  {
+    target->SetFocalDisk(source->GetFocalDisk());
+    isChanged = true;
+  }
+  if (source->GetFocalDistance() != target->GetFocalDistance())
+  {
+    target->SetFocalDistance(source->GetFocalDistance());
+    isChanged = true;
+  }
+  if (source->GetUseOffAxisProjection() != target->GetUseOffAxisProjection())
+  {
+    target->SetUseOffAxisProjection(source->GetUseOffAxisProjection());
+    isChanged = true;
+  }
+  if (!isEqual(source->GetScreenBottomLeft(), target->GetScreenBottomLeft(), 3) ||
+      !isEqual(source->GetScreenBottomRight(), target->GetScreenBottomRight(), 3) ||
+      !isEqual(source->GetScreenTopRight(), target->GetScreenTopRight(), 3))
+  {
+    target->SetScreenBottomLeft(source->GetScreenBottomLeft());
+    target->SetScreenBottomRight(source->GetScreenBottomRight());
+    target->SetScreenTopRight(source->GetScreenTopRight());
+    isChanged = true;
+  }
+  if (!isMatrixEqual(source->GetEyeTransformMatrix(), target->GetEyeTransformMatrix()))
+  {
+    target->SetEyeTransformMatrix(source->GetEyeTransformMatrix());
+    isChanged = true;
+  }
+  if (!isMatrixEqual(source->GetModelTransformMatrix(), target->GetModelTransformMatrix()))
+  {
+    target->SetModelTransformMatrix(source->GetModelTransformMatrix());
+    isChanged = true;
+  }
+
+  // User transforms are shared with the source camera instead of copied
+  if (source->GetUserTransform() != target->GetUserTransform())
+  {
+    target->SetUserTransform(source->GetUserTransform());
+    isChanged = true;
+  }
+  if (source->GetUserViewTransform() != target->GetUserViewTransform())
+  {
+    target->SetUserViewTransform(source->GetUserViewTransform());
+    isChanged = true;
+  }
+  return isChanged;
+}
+} // namespace
 
 class CameraSynchronizeStrategy
 {
@@ -20,17 +146,41 @@ public:
   virtual ~CameraSynchronizeStrategy() = default;
   virtual void UpdateCamera() = 0;
 
+  /// Camera shared with the view instead of the synchronized default camera. nullptr if the camera is copied.
+  virtual vtkCamera* GetSharedCamera() const { return nullptr; }
+
+  /// Clipping range of the default camera if known without computing the layers bounds.
+  virtual bool GetClippingRange(double range[2]) const { return false; }
+
+  /// Thickness of the clipping slab relative to the view size when the clipping range is known.
+  virtual void SetClippingSlabThickness(double relativeThickness) {}
+
+  bool IsUpdating() const { return m_isUpdating; }
+
+  /// Number of camera updates applied to the default camera and skipped as the inputs were unchanged.
+  int GetNumberOfAppliedUpdates() const { return m_nAppliedUpdates; }
+  int GetNumberOfSkippedUpdates() const { return m_nSkippedUpdates; }
+  void ResetUpdateCounters() { m_nAppliedUpdates = m_nSkippedUpdates = 0; }
+
 protected:
   vtkSmartPointer<vtkCamera> m_camera;
   vtkNew<vtkObjectEventObserver> m_eventObserver;
+  bool m_isUpdating{ false };
+  int m_nAppliedUpdates{ 0 };
+  int m_nSkippedUpdates{ 0 };
 };
 
 class DefaultCameraSynchronizeStrategy : public CameraSynchronizeStrategy
 {
 public:
-  explicit DefaultCameraSynchronizeStrategy(const vtkSmartPointer<vtkCamera>& camera, vtkRenderer* renderer)
+  explicit DefaultCameraSynchronizeStrategy(const vtkSmartPointer<vtkCamera>& camera,
+                                            vtkRenderer* renderer,
+                                            int syncMode,
+                                            const std::function<void()>& onSharedCameraChanged)
     : CameraSynchronizeStrategy(camera)
     , m_renderer(renderer)
+    , m_syncMode(syncMode)
+    , m_onSharedCameraChanged{}
   {
     m_eventObserver->SetUpdateCallback(
       [this](vtkObject* object)
@@ -47,17 +197,43 @@ public:
 
     m_eventObserver->UpdateObserver(nullptr, m_renderer, vtkCommand::ActiveCameraEvent);
     ObserveActiveCamera();
+
+    // The initial shared camera is notified by the synchronizer once the strategy is set
+    m_onSharedCameraChanged = onSharedCameraChanged;
   }
 
   void UpdateCamera() override
   {
-    if (m_observedCamera)
+    if (!m_observedCamera)
+    {
+      return;
+    }
+
+    switch (m_syncMode)
     {
-      m_camera->DeepCopy(m_observedCamera);
-      m_camera->Modified();
+      case vtkMRMLLayerDMCameraSynchronizer::SyncDeepCopy:
+        m_camera->DeepCopy(m_observedCamera);
+        m_camera->Modified();
+        ++m_nAppliedUpdates;
+        break;
+      case vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera: break;
+      default:
+      {
+        // Intermediate modifications are not meaningful, notify once the camera is complete
+        m_isUpdating = true;
+        bool isChanged = CopyChangedViewParameters(m_observedCamera, m_camera);
+        m_isUpdating = false;
+        if (isChanged)
+        {
+          m_camera->Modified();
+        }
+        ++(isChanged ? m_nAppliedUpdates : m_nSkippedUpdates);
+      }
     }
   }
 
+  vtkCamera* GetSharedCamera() const override { return m_syncMode == vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera ? m_observedCamera.GetPointer() : nullptr; }
+
 private:
   void ObserveActiveCamera() { SetObservedCamera(m_renderer ? m_renderer->GetActiveCamera() : nullptr); }
 
@@ -71,18 +247,25 @@ private:
     m_eventObserver->UpdateObserver(m_observedCamera, camera);
     m_observedCamera = camera;
     UpdateCamera();
+    if (m_syncMode == vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera && m_onSharedCameraChanged)
+    {
+      m_onSharedCameraChanged();
+    }
   }
 
   vtkWeakPointer<vtkRenderer> m_renderer;
   vtkWeakPointer<vtkCamera> m_observedCamera;
+  int m_syncMode;
+  std::function<void()> m_onSharedCameraChanged;
 };
 
 class SliceViewCameraSynchronizeStrategy : public CameraSynchronizeStrategy
 {
 public:
-  explicit SliceViewCameraSynchronizeStrategy(const vtkSmartPointer<vtkCamera>& camera, vtkMRMLSliceNode* sliceNode)
+  explicit SliceViewCameraSynchronizeStrategy(const vtkSmartPointer<vtkCamera>& camera, vtkMRMLSliceNode* sliceNode, double relativeSlabThickness)
     : CameraSynchronizeStrategy(camera)
     , m_sliceNode{ sliceNode }
+    , m_relativeSlabThickness{ relativeSlabThickness }
   {
     m_eventObserver->SetUpdateCallback(
       [this](vtkObject* object)
@@ -102,11 +285,19 @@ public:
       return;
     }
 
+    // Slice nodes are modified for many reasons not affecting the camera (layout, label display, ...).
+    // Skip the update if the camera inputs are unchanged.
+    SliceCameraInputs inputs = GetSliceCameraInputs();
+    if (m_hasInputs && inputs == m_inputs)
+    {
+      ++m_nSkippedUpdates;
+      return;
+    }
+
     // Compute view center
-    vtkMatrix4x4* xyToRas = m_sliceNode->GetXYToRAS();
-    std::array<double, 4> viewCenterXY = { 0.5 * m_sliceNode->GetDimensions()[0], 0.5 * m_sliceNode->GetDimensions()[1], 0.0, 1.0 };
+    std::array<double, 4> viewCenterXY = { 0.5 * inputs.Dimensions[0], 0.5 * inputs.Dimensions[1], 0.0, 1.0 };
     std::array<double, 4> viewCenterRAS = {};
-    xyToRas->MultiplyPoint(viewCenterXY.data(), viewCenterRAS.data());
+    vtkMatrix4x4::MultiplyPoint(inputs.XYToRAS.data(), viewCenterXY.data(), viewCenterRAS.data());
 
     // Current slice RAS coordinate is invalid (Slice was probably just created and not already displayed).
     // Avoid propagating NaN.
@@ -114,32 +305,97 @@ public:
     {
       return;
     }
+    m_inputs = inputs;
+    m_hasInputs = true;
+    ++m_nAppliedUpdates;
+
+    // Intermediate modifications are not meaningful, notify once the camera is complete
+    m_isUpdating = true;
 
     // Parallel projection and scale
     m_camera->ParallelProjectionOn();
-    m_camera->SetParallelScale(0.5 * m_sliceNode->GetFieldOfView()[1]);
+    m_camera->SetParallelScale(0.5 * inputs.FieldOfView[1]);
 
     // Set focal point
     m_camera->SetFocalPoint(viewCenterRAS.data());
 
     // View directions
-    vtkMatrix4x4* sliceToRAS = m_sliceNode->GetSliceToRAS();
-
-    std::array<double, 3> vRight = { sliceToRAS->GetElement(0, 0), sliceToRAS->GetElement(1, 0), sliceToRAS->GetElement(2, 0) };
+    const auto& sliceToRAS = inputs.SliceToRAS;
+    std::array<double, 3> vRight = { sliceToRAS[0], sliceToRAS[4], sliceToRAS[8] };
 
-    std::array<double, 3> vUp = { sliceToRAS->GetElement(0, 1), sliceToRAS->GetElement(1, 1), sliceToRAS->GetElement(2, 1) };
+    std::array<double, 3> vUp = { sliceToRAS[1], sliceToRAS[5], sliceToRAS[9] };
     m_camera->SetViewUp(vUp.data());
 
-    // Position
-    double d = m_camera->GetDistance();
+    // Position, far enough from the slice plane for the clipping slab to be centered on it
+    double d = std::max(m_camera->GetDistance(), 2.0 * GetHalfSlabThickness());
     std::array<double, 3> normal{};
     vtkMath::Cross(vRight.data(), vUp.data(), normal.data());
     double position[3] = { viewCenterRAS[0] + normal[0] * d, viewCenterRAS[1] + normal[1] * d, viewCenterRAS[2] + normal[2] * d };
     m_camera->SetPosition(position);
+
+    m_isUpdating = false;
+    m_camera->Modified();
+  }
+
+  bool GetClippingRange(double range[2]) const override
+  {
+    if (!m_hasInputs)
+    {
+      return false;
+    }
+
+    // Slab centered on the slice plane, the near plane is kept in front of the camera
+    constexpr double nearClippingPlaneTolerance = 1e-3;
+    const double halfThickness = GetHalfSlabThickness();
+    const double distance = m_camera->GetDistance();
+    range[1] = distance + halfThickness;
+    range[0] = std::max(distance - halfThickness, nearClippingPlaneTolerance * range[1]);
+    return true;
+  }
+
+  void SetClippingSlabThickness(double relativeThickness) override
+  {
+    m_relativeSlabThickness = relativeThickness;
+
+    // Move the camera away from the slice plane if the slab doesn't fit in front of it anymore
+    if (m_hasInputs && m_camera->GetDistance() < 2.0 * GetHalfSlabThickness())
+    {
+      m_hasInputs = false;
+      UpdateCamera();
+    }
   }
 
 private:
+  double GetHalfSlabThickness() const { return 0.5 * m_relativeSlabThickness * std::max(m_inputs.FieldOfView[0], m_inputs.FieldOfView[1]); }
+
+  /// Slice node properties the slice camera is computed from
+  struct SliceCameraInputs
+  {
+    std::array<double, 16> XYToRAS{};
+    std::array<double, 16> SliceToRAS{};
+    std::array<double, 3> FieldOfView{};
+    std::array<int, 3> Dimensions{};
+
+    bool operator==(const SliceCameraInputs& other) const
+    {
+      return XYToRAS == other.XYToRAS && SliceToRAS == other.SliceToRAS && FieldOfView == other.FieldOfView && Dimensions == other.Dimensions;
+    }
+  };
+
+  SliceCameraInputs GetSliceCameraInputs() const
+  {
+    SliceCameraInputs inputs;
+    vtkMatrix4x4::DeepCopy(inputs.XYToRAS.data(), m_sliceNode->GetXYToRAS());
+    vtkMatrix4x4::DeepCopy(inputs.SliceToRAS.data(), m_sliceNode->GetSliceToRAS());
+    std::copy_n(m_sliceNode->GetFieldOfView(), 3, inputs.FieldOfView.begin());
+    std::copy_n(m_sliceNode->GetDimensions(), 3, inputs.Dimensions.begin());
+    return inputs;
+  }
+
   vtkWeakPointer<vtkMRMLSliceNode> m_sliceNode;
+  SliceCameraInputs m_inputs;
+  bool m_hasInputs{ false };
+  double m_relativeSlabThickness;
 };
 
 vtkStandardNewMacro(vtkMRMLLayerDMCameraSynchronizer);
@@ -175,11 +431,91 @@ void vtkMRMLLayerDMCameraSynchronizer::SetRenderer(vtkRenderer* renderer)
   UpdateStrategy();
 }
 
+void vtkMRMLLayerDMCameraSynchronizer::SetSyncMode(int syncMode)
+{
+  if (m_syncMode == syncMode)
+  {
+    return;
+  }
+  m_syncMode = syncMode;
+  UpdateStrategy();
+}
+
+int vtkMRMLLayerDMCameraSynchronizer::GetSyncMode() const
+{
+  return m_syncMode;
+}
+
+vtkCamera* vtkMRMLLayerDMCameraSynchronizer::GetSynchronizedCamera() const
+{
+  if (m_syncStrategy)
+  {
+    if (auto sharedCamera = m_syncStrategy->GetSharedCamera())
+    {
+      return sharedCamera;
+    }
+  }
+  return m_defaultCamera;
+}
+
+bool vtkMRMLLayerDMCameraSynchronizer::IsSynchronizing() const
+{
+  return m_syncStrategy && m_syncStrategy->IsUpdating();
+}
+
+bool vtkMRMLLayerDMCameraSynchronizer::GetDefaultCameraClippingRange(double range[2]) const
+{
+  return m_syncStrategy && m_syncStrategy->GetClippingRange(range);
+}
+
+void vtkMRMLLayerDMCameraSynchronizer::SetSliceClippingSlabThickness(double relativeThickness)
+{
+  if (m_sliceClippingSlabThickness == relativeThickness)
+  {
+    return;
+  }
+  m_sliceClippingSlabThickness = relativeThickness;
+  if (m_syncStrategy)
+  {
+    m_syncStrategy->SetClippingSlabThickness(m_sliceClippingSlabThickness);
+  }
+  Modified();
+}
+
+double vtkMRMLLayerDMCameraSynchronizer::GetSliceClippingSlabThickness() const
+{
+  return m_sliceClippingSlabThickness;
+}
+
+int vtkMRMLLayerDMCameraSynchronizer::GetNumberOfAppliedUpdates() const
+{
+  return m_nAppliedUpdates + (m_syncStrategy ? m_syncStrategy->GetNumberOfAppliedUpdates() : 0);
+}
+
+int vtkMRMLLayerDMCameraSynchronizer::GetNumberOfSkippedUpdates() const
+{
+  return m_nSkippedUpdates + (m_syncStrategy ? m_syncStrategy->GetNumberOfSkippedUpdates() : 0);
+}
+
+void vtkMRMLLayerDMCameraSynchronizer::ResetUpdateCounters()
+{
+  m_nAppliedUpdates = m_nSkippedUpdates = 0;
+  if (m_syncStrategy)
+  {
+    m_syncStrategy->ResetUpdateCounters();
+  }
+}
+
 vtkMRMLLayerDMCameraSynchronizer::vtkMRMLLayerDMCameraSynchronizer()
   : m_defaultCamera{ nullptr }
   , m_renderer{ nullptr }
   , m_viewNode{ nullptr }
   , m_syncStrategy{ nullptr }
+  , m_synchronizedCamera{ nullptr }
+  , m_syncMode{ SyncChangedParameters }
+  , m_sliceClippingSlabThickness{ 1.0 }
+  , m_nAppliedUpdates{ 0 }
+  , m_nSkippedUpdates{ 0 }
 {
 }
 
@@ -187,19 +523,39 @@ vtkMRMLLayerDMCameraSynchronizer::~vtkMRMLLayerDMCameraSynchronizer() = default;
 
 void vtkMRMLLayerDMCameraSynchronizer::UpdateStrategy()
 {
+  // Keep the counters of the replaced strategy
+  if (m_syncStrategy)
+  {
+    m_nAppliedUpdates += m_syncStrategy->GetNumberOfAppliedUpdates();
+    m_nSkippedUpdates += m_syncStrategy->GetNumberOfSkippedUpdates();
+  }
+
   if (!m_defaultCamera || !m_renderer)
   {
     m_syncStrategy = nullptr;
+    UpdateSynchronizedCamera();
     return;
   }
 
   if (auto sliceNode = vtkMRMLSliceNode::SafeDownCast(m_viewNode))
   {
-    m_syncStrategy = std::make_unique<SliceViewCameraSynchronizeStrategy>(m_defaultCamera, sliceNode);
+    m_syncStrategy = std::make_unique<SliceViewCameraSynchronizeStrategy>(m_defaultCamera, sliceNode, m_sliceClippingSlabThickness);
   }
   else
   {
-    m_syncStrategy = std::make_unique<DefaultCameraSynchronizeStrategy>(m_defaultCamera, m_renderer);
+    m_syncStrategy = std::make_unique<DefaultCameraSynchronizeStrategy>(m_defaultCamera, m_renderer, m_syncMode, [this] { UpdateSynchronizedCamera(); });
   }
   m_syncStrategy->UpdateCamera();
+  UpdateSynchronizedCamera();
+}
+
+void vtkMRMLLayerDMCameraSynchronizer::UpdateSynchronizedCamera()
+{
+  vtkCamera* camera = GetSynchronizedCamera();
+  if (m_synchronizedCamera == camera)
+  {
+    return;
+  }
+  m_synchronizedCamera = camera;
+  InvokeEvent(vtkCommand::ActiveCameraEvent);
 }
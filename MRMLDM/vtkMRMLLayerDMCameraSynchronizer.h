@@ -19,12 +19,66 @@ class vtkMRMLAbstractViewNode;
 ///
 /// For SliceViews, the class monitors modified events to set the default camera aligned with the Slice view
 /// properties.
+///
+/// For other views, the synchronization depends on the \sa SyncMode. By default, only the view parameters which differ
+/// are copied and the default camera is left unmodified when the renderer camera changes don't affect them.
+/// Using SyncSharedCamera, no copy is done and the renderer camera is used as default camera.
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMCameraSynchronizer : public vtkObject
 {
 public:
   static vtkMRMLLayerDMCameraSynchronizer* New();
   vtkTypeMacro(vtkMRMLLayerDMCameraSynchronizer, vtkObject);
 
+  enum SyncMode
+  {
+    /// Deep copy the renderer camera and modify the default camera on each renderer camera modification.
+    SyncDeepCopy = 0,
+    /// Copy the view parameters of the renderer camera which differ from the default camera (default).
+    /// The default camera is not modified if no view parameter changed.
+    SyncChangedParameters,
+    /// Share the renderer camera as default camera without copy.
+    /// The overlay layers without specific camera are rendered with the renderer camera and their clipping range is
+    /// computed together with the renderer. Only for views where no pipeline needs a camera separate from the view
+    /// camera. Slice views use SyncChangedParameters.
+    SyncSharedCamera
+  };
+
+  /// @{
+  /// Set the camera synchronization mode. Default = SyncChangedParameters.
+  void SetSyncMode(int syncMode);
+  int GetSyncMode() const;
+  /// @}
+
+  /// Returns the camera the layers without specific camera should use.
+  /// The renderer camera in SyncSharedCamera mode if any, the default camera otherwise.
+  /// vtkCommand::ActiveCameraEvent is invoked when the synchronized camera changes.
+  vtkCamera* GetSynchronizedCamera() const;
+
+  /// true while the default camera is being updated by the synchronizer.
+  /// A single Modified event is triggered on the default camera once the update is complete.
+  bool IsSynchronizing() const;
+
+  /// Returns the clipping range of the default camera if it can be derived from the view without computing the layers
+  /// bounds. For slice views, the range is a slab around the slice plane (\sa SetSliceClippingSlabThickness).
+  /// \return false for other views, the clipping range is computed from the layers visible bounds.
+  bool GetDefaultCameraClippingRange(double range[2]) const;
+
+  /// @{
+  /// Thickness of the clipping slab around the slice plane for slice views, relative to the largest in-plane field of
+  /// view of the slice node. The slice camera is kept far enough from the slice plane for the slab to be centered on it.
+  /// A Modified event is invoked when the thickness changes. Default = 1.0.
+  void SetSliceClippingSlabThickness(double relativeThickness);
+  double GetSliceClippingSlabThickness() const;
+  /// @}
+
+  /// @{
+  /// Number of default camera updates applied and skipped because the synchronized inputs were unchanged
+  /// (slice node camera properties for slice views, view parameters for SyncChangedParameters).
+  int GetNumberOfAppliedUpdates() const;
+  int GetNumberOfSkippedUpdates() const;
+  void ResetUpdateCounters();
+  /// @}
+
   /// Set the view node for which the camera will be synchronized.
   void SetViewNode(vtkMRMLAbstractViewNode* viewNode);
 
@@ -43,8 +97,18 @@ private:
   /// Reset the internal strategy given current view node.
   void UpdateStrategy();
 
+  /// Invoke vtkCommand::ActiveCameraEvent if the synchronized camera changed.
+  void UpdateSynchronizedCamera();
+
   vtkSmartPointer<vtkCamera> m_defaultCamera;
   vtkWeakPointer<vtkRenderer> m_renderer;
   vtkWeakPointer<vtkMRMLAbstractViewNode> m_viewNode;
   std::unique_ptr<CameraSynchronizeStrategy> m_syncStrategy;
+  vtkWeakPointer<vtkCamera> m_synchronizedCamera;
+  int m_syncMode;
+  double m_sliceClippingSlabThickness;
+
+  // Counters of the previous strategies
+  int m_nAppliedUpdates;
+  int m_nSkippedUpdates;
 };
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "vtkMRMLLayerDMCellLocatorCache.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+#include <vtkStaticCellLocator.h>
+
+vtkStandardNewMacro(vtkMRMLLayerDMCellLocatorCache);
+
+vtkSmartPointer<vtkMRMLLayerDMCellLocatorCache> vtkMRMLLayerDMCellLocatorCache::GetInstance()
+{
+  static vtkSmartPointer<vtkMRMLLayerDMCellLocatorCache> instance = vtkSmartPointer<vtkMRMLLayerDMCellLocatorCache>::New();
+  return instance;
+}
+
+vtkMRMLLayerDMCellLocatorCache::vtkMRMLLayerDMCellLocatorCache()
+  : m_entries{}
+  , m_entryMap{}
+  , m_asyncBuilds{}
+  , m_isAsynchronousBuild{ false }
+  , m_lastBuildId{ 0 }
+  , m_memoryCap{ 256 * 1024 }
+  , m_memorySize{ 0 }
+{
+}
+
+vtkMRMLLayerDMCellLocatorCache::~vtkMRMLLayerDMCellLocatorCache()
+{
+  Clear();
+  JoinAsyncBuilds(true);
+}
+
+vtkSmartPointer<vtkAbstractCellLocator> vtkMRMLLayerDMCellLocatorCache::GetLocator(vtkPolyData* polyData)
+{
+  return GetLocator(polyData, true);
+}
+
+vtkSmartPointer<vtkAbstractCellLocator> vtkMRMLLayerDMCellLocatorCache::GetLocatorIfReady(vtkPolyData* polyData)
+{
+  return GetLocator(polyData, false);
+}
+
+vtkSmartPointer<vtkAbstractCellLocator> vtkMRMLLayerDMCellLocatorCache::GetLocator(vtkPolyData* polyData, bool isBlocking)
+{
+  JoinAsyncBuilds(false);
+  if (!polyData || polyData->GetNumberOfCells() == 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RemoveDeletedEntries();
+    return nullptr;
+  }
+
+  std::shared_future<vtkSmartPointer<vtkStaticCellLocator>> pendingLocator;
+  unsigned long buildId = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RemoveDeletedEntries();
+    auto it = FindUpToDateEntry(polyData);
+    if (it != m_entries.end())
+    {
+      // Move the entry to the front of the least recently used list
+      m_entries.splice(m_entries.begin(), m_entries, it);
+      if (it->Locator)
+      {
+        return it->Locator;
+      }
+      pendingLocator = it->PendingLocator;
+      buildId = it->BuildId;
+    }
+  }
+
+  std::packaged_task<vtkSmartPointer<vtkStaticCellLocator>()> build;
+  if (!pendingLocator.valid())
+  {
+    // Copy the polydata on the calling thread, outside of the lock, so that the build doesn't share its arrays
+    auto snapshot = vtkSmartPointer<vtkPolyData>::New();
+    snapshot->DeepCopy(polyData);
+    const bool isAsync = !isBlocking && GetAsynchronousBuild();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = FindUpToDateEntry(polyData);
+    if (it != m_entries.end())
+    {
+      // Another caller started the build in the meantime
+      if (it->Locator)
+      {
+        return it->Locator;
+      }
+      pendingLocator = it->PendingLocator;
+      buildId = it->BuildId;
+    }
+    else
+    {
+      Entry entry;
+      entry.Key = polyData;
+      entry.PolyData = polyData;
+      entry.MTime = polyData->GetMTime();
+      entry.BuildId = ++m_lastBuildId;
+      if (isAsync)
+      {
+        entry.PendingLocator = StartAsyncBuild(snapshot);
+      }
+      else
+      {
+        build = std::packaged_task<vtkSmartPointer<vtkStaticCellLocator>()>([snapshot] { return BuildLocator(snapshot); });
+        entry.PendingLocator = build.get_future().share();
+      }
+      pendingLocator = entry.PendingLocator;
+      buildId = entry.BuildId;
+      m_entries.emplace_front(std::move(entry));
+      m_entryMap[polyData] = m_entries.begin();
+    }
+  }
+
+  // Synchronous builds run on the calling thread without holding the lock
+  if (build.valid())
+  {
+    build();
+  }
+
+  if (!isBlocking && pendingLocator.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    return nullptr;
+  }
+
+  auto locator = pendingLocator.get();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  CompletePendingBuild(polyData, buildId);
+  EvictEntries();
+  return locator;
+}
+
+vtkMRMLLayerDMCellLocatorCache::EntryList::iterator vtkMRMLLayerDMCellLocatorCache::FindUpToDateEntry(vtkPolyData* polyData)
+{
+  const auto found = m_entryMap.find(polyData);
+  if (found == m_entryMap.end())
+  {
+    return m_entries.end();
+  }
+
+  // Remove the entry if the polydata was modified or if a new polydata was allocated at the same address
+  auto it = found->second;
+  if (it->PolyData != polyData || it->MTime != polyData->GetMTime())
+  {
+    EraseEntry(it);
+    return m_entries.end();
+  }
+  return it;
+}
+
+void vtkMRMLLayerDMCellLocatorCache::CompletePendingBuild(vtkPolyData* polyData, unsigned long buildId)
+{
+  // Entries modified or removed during the build are not updated
+  const auto found = m_entryMap.find(polyData);
+  if (found == m_entryMap.end() || found->second->BuildId != buildId || found->second->Locator)
+  {
+    return;
+  }
+
+  auto& entry = *found->second;
+  entry.Locator = entry.PendingLocator.get();
+  entry.PendingLocator = {};
+  entry.MemorySize = EstimateMemorySizeInKiB(entry.Locator);
+  m_memorySize += entry.MemorySize;
+}
+
+void vtkMRMLLayerDMCellLocatorCache::EvictEntries()
+{
+  // Evict least recently used built locators while keeping the most recently used one.
+  // Locators being built are not accounted in the memory size and are not evicted.
+  auto it = m_entries.end();
+  while (m_memorySize > m_memoryCap && it != m_entries.begin() && std::prev(it) != m_entries.begin())
+  {
+    --it;
+    if (it->Locator)
+    {
+      it = EraseEntry(it);
+    }
+  }
+}
+
+void vtkMRMLLayerDMCellLocatorCache::RemoveDeletedEntries()
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    it = !it->PolyData ? EraseEntry(it) : std::next(it);
+  }
+}
+
+vtkMRMLLayerDMCellLocatorCache::EntryList::iterator vtkMRMLLayerDMCellLocatorCache::EraseEntry(EntryList::iterator it)
+{
+  m_entryMap.erase(it->Key);
+  m_memorySize -= it->MemorySize;
+  return m_entries.erase(it);
+}
+
+std::shared_future<vtkSmartPointer<vtkStaticCellLocator>> vtkMRMLLayerDMCellLocatorCache::StartAsyncBuild(const vtkSmartPointer<vtkPolyData>& polyData)
+{
+  // Unlike std::async futures, promise futures don't block on destruction. Entries can be erased under the lock
+  // without waiting for their build.
+  std::promise<vtkSmartPointer<vtkStaticCellLocator>> promise;
+  AsyncBuild asyncBuild;
+  asyncBuild.Locator = promise.get_future().share();
+  asyncBuild.Worker = std::thread(
+    [polyData, promise = std::move(promise)]() mutable
+    {
+      try
+      {
+        promise.set_value(BuildLocator(polyData));
+      }
+      catch (...)
+      {
+        promise.set_exception(std::current_exception());
+      }
+    });
+  m_asyncBuilds.emplace_back(std::move(asyncBuild));
+  return m_asyncBuilds.back().Locator;
+}
+
+void vtkMRMLLayerDMCellLocatorCache::JoinAsyncBuilds(bool isWaiting)
+{
+  // Workers are joined outside of the lock
+  std::list<AsyncBuild> joinedBuilds;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_asyncBuilds.begin(); it != m_asyncBuilds.end();)
+    {
+      auto next = std::next(it);
+      if (isWaiting || it->Locator.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      {
+        joinedBuilds.splice(joinedBuilds.end(), m_asyncBuilds, it);
+      }
+      it = next;
+    }
+  }
+
+  for (auto& asyncBuild : joinedBuilds)
+  {
+    asyncBuild.Worker.join();
+  }
+}
+
+vtkSmartPointer<vtkStaticCellLocator> vtkMRMLLayerDMCellLocatorCache::BuildLocator(const vtkSmartPointer<vtkPolyData>& polyData)
+{
+  auto locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+  locator->SetDataSet(polyData);
+  locator->BuildLocator();
+  return locator;
+}
+
+unsigned long vtkMRMLLayerDMCellLocatorCache::EstimateMemorySizeInKiB(vtkStaticCellLocator* locator)
+{
+  if (!locator || !locator->GetDataSet())
+  {
+    return 0;
+  }
+
+  // Cell to bin map, bin offsets and cached cell bounds, and the polydata copy owned by the locator
+  const auto nCells = static_cast<unsigned long>(locator->GetDataSet()->GetNumberOfCells());
+  const int* divisions = locator->GetDivisions();
+  const auto nBins = static_cast<unsigned long>(divisions[0]) * divisions[1] * divisions[2];
+  const unsigned long bytes = nCells * (2 * sizeof(vtkIdType) + 6 * sizeof(double)) + nBins * sizeof(vtkIdType);
+  return bytes / 1024 + 1 + locator->GetDataSet()->GetActualMemorySize();
+}
+
+void vtkMRMLLayerDMCellLocatorCache::SetAsynchronousBuild(bool isEnabled)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_isAsynchronousBuild = isEnabled;
+}
+
+bool vtkMRMLLayerDMCellLocatorCache::GetAsynchronousBuild() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_isAsynchronousBuild;
+}
+
+void vtkMRMLLayerDMCellLocatorCache::SetMemoryCapInKiB(unsigned long memoryCap)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_memoryCap = memoryCap;
+  EvictEntries();
+}
+
+unsigned long vtkMRMLLayerDMCellLocatorCache::GetMemoryCapInKiB() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryCap;
+}
+
+unsigned long vtkMRMLLayerDMCellLocatorCache::GetMemorySizeInKiB() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memorySize;
+}
+
+int vtkMRMLLayerDMCellLocatorCache::GetNumberOfLocators() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<int>(m_entries.size());
+}
+
+void vtkMRMLLayerDMCellLocatorCache::RemoveLocator(vtkPolyData* polyData)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto found = m_entryMap.find(polyData);
+  if (found != m_entryMap.end())
+  {
+    EraseEntry(found->second);
+  }
+}
+
+void vtkMRMLLayerDMCellLocatorCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entryMap.clear();
+  m_entries.clear();
+  m_memorySize = 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+#include <vtkWrappingHints.h>
+
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+class vtkAbstractCellLocator;
+class vtkPolyData;
+class vtkStaticCellLocator;
+
+/// \brief Cache of cell locators shared by the pipelines of all the views.
+///
+/// Pipelines hit testing against polydata can query the cache instead of building and maintaining their own locators.
+/// Locators are keyed on the polydata and rebuilt when the polydata MTime changes.
+///
+/// Locators are built lazily, either synchronously with \sa GetLocator or on a worker thread with
+/// \sa GetLocatorIfReady when asynchronous build is enabled. Locators are built on a deep copy of the polydata taken by
+/// the calling thread, so that the builds don't race with later edits of the polydata and the cache doesn't extend the
+/// lifetime of the cached polydata. The copy is accounted in the estimated memory of the locator.
+///
+/// Builds run outside of the cache lock. A slow build only blocks the callers requesting the same polydata, which wait
+/// for the build in progress instead of starting a new one. Asynchronous builds run on worker threads owned by the
+/// cache, joined once completed and on cache destruction.
+///
+/// Least recently used locators are evicted when the estimated memory of the cache exceeds the memory cap.
+/// Locators of deleted polydata are evicted on the next cache access.
+///
+/// The cache is accessible through \sa vtkMRMLLayerDMPipelineManager::GetCellLocatorCache and is thread-safe.
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMCellLocatorCache : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMCellLocatorCache* New();
+  vtkTypeMacro(vtkMRMLLayerDMCellLocatorCache, vtkObject);
+
+  /// \brief Singleton instance of the cache shared by the pipeline managers
+  static vtkSmartPointer<vtkMRMLLayerDMCellLocatorCache> GetInstance();
+
+  /// Returns an up-to-date locator for the input polydata.
+  /// Builds the locator synchronously if it is missing or outdated.
+  /// nullptr if the input polydata is nullptr or has no cells.
+  /// The returned locator stays valid after its eviction from the cache.
+  /// The python GIL is released during the call.
+  VTK_UNBLOCKTHREADS vtkSmartPointer<vtkAbstractCellLocator> GetLocator(vtkPolyData* polyData);
+
+  /// Returns the up-to-date locator for the input polydata if it is already built.
+  /// Otherwise, schedules its build and returns nullptr.
+  /// The build is done on a worker thread if asynchronous build is enabled, synchronously otherwise.
+  vtkSmartPointer<vtkAbstractCellLocator> GetLocatorIfReady(vtkPolyData* polyData);
+
+  /// @{
+  /// Build the locators on a worker thread in \sa GetLocatorIfReady. Disabled by default.
+  void SetAsynchronousBuild(bool isEnabled);
+  bool GetAsynchronousBuild() const;
+  /// @}
+
+  /// @{
+  /// Max estimated memory used by the cached locators in KiB. Default = 256 MiB.
+  void SetMemoryCapInKiB(unsigned long memoryCap);
+  unsigned long GetMemoryCapInKiB() const;
+  /// @}
+
+  /// Estimated memory used by the cached locators in KiB.
+  unsigned long GetMemorySizeInKiB() const;
+
+  /// Number of locators in the cache, including the locators being built.
+  int GetNumberOfLocators() const;
+
+  /// Remove the locator associated with the input polydata if any.
+  void RemoveLocator(vtkPolyData* polyData);
+
+  /// Remove all the locators from the cache.
+  void Clear();
+
+protected:
+  vtkMRMLLayerDMCellLocatorCache();
+  ~vtkMRMLLayerDMCellLocatorCache() override;
+
+private:
+  struct Entry
+  {
+    vtkPolyData* Key{ nullptr };
+    vtkWeakPointer<vtkPolyData> PolyData;
+    vtkMTimeType MTime{ 0 };
+    vtkSmartPointer<vtkStaticCellLocator> Locator;
+    std::shared_future<vtkSmartPointer<vtkStaticCellLocator>> PendingLocator;
+    unsigned long BuildId{ 0 };
+    unsigned long MemorySize{ 0 };
+  };
+  using EntryList = std::list<Entry>;
+
+  struct AsyncBuild
+  {
+    std::thread Worker;
+    std::shared_future<vtkSmartPointer<vtkStaticCellLocator>> Locator;
+  };
+
+  static vtkSmartPointer<vtkStaticCellLocator> BuildLocator(const vtkSmartPointer<vtkPolyData>& polyData);
+  static unsigned long EstimateMemorySizeInKiB(vtkStaticCellLocator* locator);
+
+  vtkSmartPointer<vtkAbstractCellLocator> GetLocator(vtkPolyData* polyData, bool isBlocking);
+  EntryList::iterator FindUpToDateEntry(vtkPolyData* polyData);
+
+  /// Store the locator of the completed build in its entry if the entry still exists. Lock is expected to be held.
+  void CompletePendingBuild(vtkPolyData* polyData, unsigned long buildId);
+  void EvictEntries();
+  void RemoveDeletedEntries();
+  EntryList::iterator EraseEntry(EntryList::iterator it);
+
+  /// Start the build of the locator on a worker thread owned by the cache. Lock is expected to be held.
+  std::shared_future<vtkSmartPointer<vtkStaticCellLocator>> StartAsyncBuild(const vtkSmartPointer<vtkPolyData>& polyData);
+
+  /// Join the worker threads of the completed asynchronous builds, or of all the builds if \param isWaiting is true.
+  void JoinAsyncBuilds(bool isWaiting);
+
+  mutable std::mutex m_mutex;
+
+  // Entries ordered from the most recently used to the least recently used
+  EntryList m_entries;
+  std::map<vtkPolyData*, EntryList::iterator> m_entryMap;
+  std::list<AsyncBuild> m_asyncBuilds;
+
+  bool m_isAsynchronousBuild;
+  unsigned long m_lastBuildId;
+  unsigned long m_memoryCap;
+  unsigned long m_memorySize;
+};
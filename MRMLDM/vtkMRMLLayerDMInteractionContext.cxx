@@ -0,0 +1,295 @@
+#include "vtkMRMLLayerDMInteractionContext.h"
+
+#include "vtkMRMLInteractionEventData.h"
+
+#include <vtkCamera.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkMRMLLayerDMInteractionContext);
+
+vtkMRMLLayerDMInteractionContext::vtkMRMLLayerDMInteractionContext()
+  : m_renderer{ nullptr }
+  , m_camera{ nullptr }
+  , m_cameraMTime{ 0 }
+  , m_displayRows{}
+  , m_viewportOrigin{}
+  , m_viewportSize{}
+  , m_dpiScale{ 1.0 }
+  , m_isDisplayPositionValid{ false }
+  , m_displayPosition{}
+  , m_pickRayOrigin{}
+  , m_pickRayDirection{}
+{
+}
+
+void vtkMRMLLayerDMInteractionContext::Update(vtkRenderer* renderer, vtkMRMLInteractionEventData* eventData)
+{
+  m_renderer = renderer;
+  UpdateProjection();
+
+  m_isDisplayPositionValid = eventData && eventData->IsDisplayPositionValid();
+  if (m_isDisplayPositionValid)
+  {
+    const int* displayPosition = eventData->GetDisplayPosition();
+    m_displayPosition = { static_cast<double>(displayPosition[0]), static_cast<double>(displayPosition[1]) };
+  }
+  UpdatePickRay();
+}
+
+void vtkMRMLLayerDMInteractionContext::UpdateProjection()
+{
+  vtkCamera* camera = m_renderer ? m_renderer->GetActiveCamera() : nullptr;
+  if (!camera)
+  {
+    m_camera = nullptr;
+    m_projection->Identity();
+    m_displayRows = {};
+    return;
+  }
+
+  const int* size = m_renderer->GetSize();
+  const int* origin = m_renderer->GetOrigin();
+  const std::array<int, 2> viewportSize = { size[0], size[1] };
+  const std::array<int, 2> viewportOrigin = { origin[0], origin[1] };
+
+  // Projection is only recomputed once per camera or viewport change (usually once per frame)
+  if (camera == m_camera && camera->GetMTime() == m_cameraMTime && viewportSize == m_viewportSize && viewportOrigin == m_viewportOrigin)
+  {
+    return;
+  }
+
+  m_camera = camera;
+  m_cameraMTime = camera->GetMTime();
+  m_viewportSize = viewportSize;
+  m_viewportOrigin = viewportOrigin;
+  m_dpiScale = m_renderer->GetRenderWindow() ? m_renderer->GetRenderWindow()->GetDPI() / 72.0 : 1.0;
+  m_projection->DeepCopy(camera->GetCompositeProjectionTransformMatrix(m_renderer->GetTiledAspectRatio(), -1, 1));
+
+  // Fold the normalized view to display transform in the projection rows :
+  // display = ((row . p) / w + 1) * 0.5 * size + origin = (row . p * 0.5 * size + w * (0.5 * size + origin)) / w
+  for (int iAxis = 0; iAxis < 2; ++iAxis)
+  {
+    const double scale = 0.5 * m_viewportSize[iAxis];
+    const double offset = scale + m_viewportOrigin[iAxis];
+    for (int j = 0; j < 4; ++j)
+    {
+      m_displayRows[iAxis * 4 + j] = scale * m_projection->GetElement(iAxis, j) + offset * m_projection->GetElement(3, j);
+    }
+  }
+  for (int j = 0; j < 4; ++j)
+  {
+    m_displayRows[8 + j] = m_projection->GetElement(3, j);
+  }
+}
+
+void vtkMRMLLayerDMInteractionContext::UpdatePickRay()
+{
+  m_pickRayOrigin = {};
+  m_pickRayDirection = {};
+  if (!m_isDisplayPositionValid || !m_camera || m_viewportSize[0] <= 0 || m_viewportSize[1] <= 0)
+  {
+    return;
+  }
+
+  double inverse[16];
+  vtkMatrix4x4::Invert(m_projection->GetData(), inverse);
+
+  const double x = 2.0 * (m_displayPosition[0] - m_viewportOrigin[0]) / m_viewportSize[0] - 1.0;
+  const double y = 2.0 * (m_displayPosition[1] - m_viewportOrigin[1]) / m_viewportSize[1] - 1.0;
+  double nearView[4] = { x, y, -1.0, 1.0 };
+  double farView[4] = { x, y, 1.0, 1.0 };
+  double nearWorld[4];
+  double farWorld[4];
+  vtkMatrix4x4::MultiplyPoint(inverse, nearView, nearWorld);
+  vtkMatrix4x4::MultiplyPoint(inverse, farView, farWorld);
+  if (nearWorld[3] == 0.0 || farWorld[3] == 0.0)
+  {
+    return;
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    m_pickRayOrigin[i] = nearWorld[i] / nearWorld[3];
+    m_pickRayDirection[i] = farWorld[i] / farWorld[3] - m_pickRayOrigin[i];
+  }
+  vtkMath::Normalize(m_pickRayDirection.data());
+}
+
+vtkRenderer* vtkMRMLLayerDMInteractionContext::GetRenderer() const
+{
+  return m_renderer;
+}
+
+vtkMatrix4x4* vtkMRMLLayerDMInteractionContext::GetCompositeProjectionMatrix() const
+{
+  return m_projection;
+}
+
+void vtkMRMLLayerDMInteractionContext::GetViewportOrigin(int origin[2]) const
+{
+  origin[0] = m_viewportOrigin[0];
+  origin[1] = m_viewportOrigin[1];
+}
+
+void vtkMRMLLayerDMInteractionContext::GetViewportSize(int size[2]) const
+{
+  size[0] = m_viewportSize[0];
+  size[1] = m_viewportSize[1];
+}
+
+double vtkMRMLLayerDMInteractionContext::GetDPIScale() const
+{
+  return m_dpiScale;
+}
+
+bool vtkMRMLLayerDMInteractionContext::IsDisplayPositionValid() const
+{
+  return m_isDisplayPositionValid;
+}
+
+void vtkMRMLLayerDMInteractionContext::GetDisplayPosition(double position[2]) const
+{
+  position[0] = m_displayPosition[0];
+  position[1] = m_displayPosition[1];
+}
+
+bool vtkMRMLLayerDMInteractionContext::GetPickRay(double origin[3], double direction[3]) const
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    origin[i] = m_pickRayOrigin[i];
+    direction[i] = m_pickRayDirection[i];
+  }
+  return m_isDisplayPositionValid && m_camera;
+}
+
+bool vtkMRMLLayerDMInteractionContext::WorldToDisplay(const double world[3], double display[2]) const
+{
+  const auto& r = m_displayRows;
+  const double w = r[8] * world[0] + r[9] * world[1] + r[10] * world[2] + r[11];
+  if (w <= 0.0)
+  {
+    return false;
+  }
+
+  display[0] = (r[0] * world[0] + r[1] * world[1] + r[2] * world[2] + r[3]) / w;
+  display[1] = (r[4] * world[0] + r[5] * world[1] + r[6] * world[2] + r[7]) / w;
+  return true;
+}
+
+void vtkMRMLLayerDMInteractionContext::ProjectPoints(const double* worldPoints, vtkIdType nPoints, double* displayPoints) const
+{
+  // Matrix coefficients are copied to locals so that the loop has no aliasing and can be auto-vectorized
+  const double r0 = m_displayRows[0], r1 = m_displayRows[1], r2 = m_displayRows[2], r3 = m_displayRows[3];
+  const double r4 = m_displayRows[4], r5 = m_displayRows[5], r6 = m_displayRows[6], r7 = m_displayRows[7];
+  const double r8 = m_displayRows[8], r9 = m_displayRows[9], r10 = m_displayRows[10], r11 = m_displayRows[11];
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  for (vtkIdType i = 0; i < nPoints; ++i)
+  {
+    const double x = worldPoints[3 * i];
+    const double y = worldPoints[3 * i + 1];
+    const double z = worldPoints[3 * i + 2];
+    const double w = r8 * x + r9 * y + r10 * z + r11;
+    const double invW = w > 0.0 ? 1.0 / w : nan;
+    displayPoints[2 * i] = (r0 * x + r1 * y + r2 * z + r3) * invW;
+    displayPoints[2 * i + 1] = (r4 * x + r5 * y + r6 * z + r7) * invW;
+  }
+}
+
+template <typename T>
+double vtkMRMLLayerDMInteractionContext::ComputeMinDisplayDistance2Impl(const T* worldPoints, vtkIdType nPoints, vtkIdType* closestId) const
+{
+  if (closestId)
+  {
+    *closestId = -1;
+  }
+
+  double minDistance2 = VTK_DOUBLE_MAX;
+  if (!m_isDisplayPositionValid || !worldPoints)
+  {
+    return minDistance2;
+  }
+
+  const double r0 = m_displayRows[0], r1 = m_displayRows[1], r2 = m_displayRows[2], r3 = m_displayRows[3];
+  const double r4 = m_displayRows[4], r5 = m_displayRows[5], r6 = m_displayRows[6], r7 = m_displayRows[7];
+  const double r8 = m_displayRows[8], r9 = m_displayRows[9], r10 = m_displayRows[10], r11 = m_displayRows[11];
+  const double px = m_displayPosition[0];
+  const double py = m_displayPosition[1];
+
+  // Distance is compared in homogeneous coordinates to avoid one division per point :
+  // |d / w - p|^2 = |d - p * w|^2 / w^2
+  vtkIdType minId = -1;
+  for (vtkIdType i = 0; i < nPoints; ++i)
+  {
+    const double x = worldPoints[3 * i];
+    const double y = worldPoints[3 * i + 1];
+    const double z = worldPoints[3 * i + 2];
+    const double w = r8 * x + r9 * y + r10 * z + r11;
+    const double dx = (r0 * x + r1 * y + r2 * z + r3) - px * w;
+    const double dy = (r4 * x + r5 * y + r6 * z + r7) - py * w;
+    const double w2 = w * w;
+    const double distance2 = (dx * dx + dy * dy) / w2;
+    if (w > 0.0 && distance2 < minDistance2)
+    {
+      minDistance2 = distance2;
+      minId = i;
+    }
+  }
+
+  if (closestId)
+  {
+    *closestId = minId;
+  }
+  return minDistance2;
+}
+
+double vtkMRMLLayerDMInteractionContext::ComputeMinDisplayDistance2(const double* worldPoints, vtkIdType nPoints, vtkIdType* closestId) const
+{
+  return ComputeMinDisplayDistance2Impl(worldPoints, nPoints, closestId);
+}
+
+double vtkMRMLLayerDMInteractionContext::ComputeMinDisplayDistance2(const float* worldPoints, vtkIdType nPoints, vtkIdType* closestId) const
+{
+  return ComputeMinDisplayDistance2Impl(worldPoints, nPoints, closestId);
+}
+
+double vtkMRMLLayerDMInteractionContext::ComputeMinDisplayDistance2(vtkPoints* points, vtkIdType* closestId) const
+{
+  if (!points)
+  {
+    if (closestId)
+    {
+      *closestId = -1;
+    }
+    return VTK_DOUBLE_MAX;
+  }
+
+  // Use the raw point buffers when possible
+  if (auto doubleArray = vtkDoubleArray::FastDownCast(points->GetData()))
+  {
+    return ComputeMinDisplayDistance2(doubleArray->GetPointer(0), points->GetNumberOfPoints(), closestId);
+  }
+  if (auto floatArray = vtkFloatArray::FastDownCast(points->GetData()))
+  {
+    return ComputeMinDisplayDistance2(floatArray->GetPointer(0), points->GetNumberOfPoints(), closestId);
+  }
+
+  std::vector<double> worldPoints(3 * points->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    points->GetPoint(i, &worldPoints[3 * i]);
+  }
+  return ComputeMinDisplayDistance2(worldPoints.data(), points->GetNumberOfPoints(), closestId);
+}
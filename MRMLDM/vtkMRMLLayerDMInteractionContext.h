@@ -0,0 +1,110 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObject.h>
+#include <vtkWeakPointer.h>
+#include <vtkWrappingHints.h>
+
+#include <array>
+
+class vtkCamera;
+class vtkMRMLInteractionEventData;
+class vtkPoints;
+class vtkRenderer;
+
+/// \brief Renderer projection state shared by the pipelines during interaction event processing.
+///
+/// The context is built once per renderer and per interaction event by \sa vtkMRMLLayerDMInteractionLogic and
+/// is accessible to the pipelines through \sa vtkMRMLLayerDMPipelineI::GetInteractionContext.
+///
+/// The composite projection matrix and viewport are only recomputed when the renderer camera or size changes.
+/// The event display position and pick ray are refreshed for each event.
+///
+/// Batch helpers project world points to display and compute the min squared display distance to the event position
+/// so that widget pipelines don't need to recompute the world to display transforms.
+/// Once updated, the context is read-only and can be used concurrently by thread-safe pipelines.
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMInteractionContext : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMInteractionContext* New();
+  vtkTypeMacro(vtkMRMLLayerDMInteractionContext, vtkObject);
+
+  /// Refresh the context for the input renderer and event.
+  /// Projection matrix is only recomputed if the renderer's camera or size has changed since the last update.
+  void Update(vtkRenderer* renderer, vtkMRMLInteractionEventData* eventData);
+
+  /// Returns the renderer of the last update.
+  vtkRenderer* GetRenderer() const;
+
+  /// Returns the world to normalized view coordinates matrix of the renderer's active camera.
+  vtkMatrix4x4* GetCompositeProjectionMatrix() const;
+
+  /// @{
+  /// Renderer viewport lower left corner and size in display pixels.
+  void GetViewportOrigin(int origin[2]) const;
+  void GetViewportSize(int size[2]) const;
+  /// @}
+
+  /// Render window DPI relative to the VTK default DPI (72).
+  double GetDPIScale() const;
+
+  /// @{
+  /// Event display position. Only valid if the event has a valid display position.
+  bool IsDisplayPositionValid() const;
+  void GetDisplayPosition(double position[2]) const;
+  /// @}
+
+  /// Pick ray going through the event display position from the near plane to the far plane.
+  /// \param origin: World position of the ray on the near plane.
+  /// \param direction: Normalized ray direction.
+  /// \return false if the display position is invalid.
+  bool GetPickRay(double origin[3], double direction[3]) const;
+
+  /// Convert the input world position to display.
+  /// \return false if the point is behind the camera.
+  bool WorldToDisplay(const double world[3], double display[2]) const;
+
+  /// Project \param nPoints contiguous xyz \param worldPoints to contiguous xy \param displayPoints.
+  /// Points behind the camera are projected to NaN.
+  void ProjectPoints(const double* worldPoints, vtkIdType nPoints, double* displayPoints) const;
+
+  /// @{
+  /// Returns the min squared display distance between the projected world points and the event display position.
+  /// \param closestId: Optional output index of the closest point (-1 if none).
+  /// \return VTK_DOUBLE_MAX if no point is visible or display position is invalid.
+  double ComputeMinDisplayDistance2(const double* worldPoints, vtkIdType nPoints, vtkIdType* closestId = nullptr) const;
+  double ComputeMinDisplayDistance2(const float* worldPoints, vtkIdType nPoints, vtkIdType* closestId = nullptr) const;
+  VTK_UNBLOCKTHREADS double ComputeMinDisplayDistance2(vtkPoints* points, vtkIdType* closestId = nullptr) const;
+  /// @}
+
+protected:
+  vtkMRMLLayerDMInteractionContext();
+  ~vtkMRMLLayerDMInteractionContext() override = default;
+
+private:
+  void UpdateProjection();
+  void UpdatePickRay();
+
+  template <typename T>
+  double ComputeMinDisplayDistance2Impl(const T* worldPoints, vtkIdType nPoints, vtkIdType* closestId) const;
+
+  vtkWeakPointer<vtkRenderer> m_renderer;
+  vtkWeakPointer<vtkCamera> m_camera;
+  vtkNew<vtkMatrix4x4> m_projection;
+  vtkMTimeType m_cameraMTime;
+
+  // Rows 0, 1 and 3 of the projection matrix with the viewport transform applied (display x, display y, w)
+  std::array<double, 12> m_displayRows;
+
+  std::array<int, 2> m_viewportOrigin;
+  std::array<int, 2> m_viewportSize;
+  double m_dpiScale;
+
+  bool m_isDisplayPositionValid;
+  std::array<double, 2> m_displayPosition;
+  std::array<double, 3> m_pickRayOrigin;
+  std::array<double, 3> m_pickRayDirection;
+};
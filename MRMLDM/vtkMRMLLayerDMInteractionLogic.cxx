@@ -1,10 +1,13 @@
 #include "vtkMRMLLayerDMInteractionLogic.h"
 
+#include "vtkMRMLLayerDMInteractionContext.h"
 #include "vtkMRMLLayerDMPipelineI.h"
 #include "vtkMRMLInteractionEventData.h"
 
 #include <vtkMRMLAbstractWidget.h>
 #include <vtkObjectFactory.h>
+#include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 
 vtkStandardNewMacro(vtkMRMLLayerDMInteractionLogic);
 
@@ -17,6 +20,19 @@ vtkMRMLLayerDMInteractionLogic::vtkMRMLLayerDMInteractionLogic()
   : m_prevFocusedPipeline{ nullptr }
   , m_canProcess{}
   , m_viewNode{ nullptr }
+  , m_contextEventData{ nullptr }
+  , m_contextEventIndex{ 0 }
+  , m_isParallelEvaluation{ true }
+  , m_isHoverCoalescing{ false }
+  , m_maxHoverDispatchRate{ 0 }
+  , m_isRenderPending{ false }
+  , m_isHoverDispatchedSinceRender{ false }
+  , m_isLastEventCoalesced{ false }
+  , m_lastCanProcess{ false }
+  , m_lastDidProcess{ false }
+  , m_lastDistance2{ std::numeric_limits<double>::max() }
+  , m_pendingHoverEvent{ nullptr }
+  , m_lastHoverDispatchTime{}
 {
 }
 
@@ -52,28 +68,177 @@ std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> vtkMRMLLayerDMInteractionL
   return m_canProcess;
 }
 
+int vtkMRMLLayerDMInteractionLogic::GetNumberOfCanProcessPipelines() const
+{
+  return static_cast<int>(m_canProcess.size());
+}
+
+vtkMRMLLayerDMPipelineI* vtkMRMLLayerDMInteractionLogic::GetCanProcessPipeline(int index) const
+{
+  if (index < 0 || index >= GetNumberOfCanProcessPipelines())
+  {
+    return nullptr;
+  }
+  return m_canProcess[index];
+}
+
+vtkMRMLLayerDMInteractionContext* vtkMRMLLayerDMInteractionLogic::GetInteractionContext(vtkRenderer* renderer) const
+{
+  if (!renderer || !m_contextEventData)
+  {
+    return nullptr;
+  }
+
+  // The context is only updated by its first request of the event and is read-only afterwards
+  std::lock_guard<std::mutex> lock(m_contextsMutex);
+  auto& entry = m_contexts[renderer];
+  if (!entry.Context)
+  {
+    entry.Context = vtkSmartPointer<vtkMRMLLayerDMInteractionContext>::New();
+  }
+
+  if (entry.EventIndex != m_contextEventIndex)
+  {
+    entry.Context->Update(renderer, m_contextEventData);
+    entry.EventIndex = m_contextEventIndex;
+  }
+  return entry.Context;
+}
+
+void vtkMRMLLayerDMInteractionLogic::ResetInteractionContexts(vtkMRMLInteractionEventData* eventData)
+{
+  // Contexts are rebuilt on their next request
+  m_contextEventData = eventData;
+  ++m_contextEventIndex;
+
+  // Remove contexts of deleted renderers
+  for (auto it = m_contexts.begin(); it != m_contexts.end();)
+  {
+    it = !it->first ? m_contexts.erase(it) : std::next(it);
+  }
+}
+
+void vtkMRMLLayerDMInteractionLogic::EvaluateCanProcessPipelines(vtkMRMLInteractionEventData* eventData)
+{
+  m_canProcessResults.assign(m_pipelines.size(), std::make_tuple(false, std::numeric_limits<double>::max(), 0, 0u));
+  m_threadSafeIndices.clear();
+  for (auto& batch : m_batchIndices)
+  {
+    batch.second.clear();
+  }
+
+  // Evaluate the pipelines which are not thread-safe nor batched on the calling thread
+  for (size_t iPipeline = 0; iPipeline < m_pipelines.size(); ++iPipeline)
+  {
+    const auto& pipeline = m_pipelines[iPipeline];
+    if (pipeline->IsCanProcessInteractionEventThreadSafe())
+    {
+      m_threadSafeIndices.emplace_back(iPipeline);
+      continue;
+    }
+
+    if (auto batchKey = pipeline->GetCanProcessBatchKey())
+    {
+      m_batchIndices[batchKey].emplace_back(iPipeline);
+      continue;
+    }
+
+    auto& [canProcess, distance2, widgetState, renderLayer] = m_canProcessResults[iPipeline];
+    canProcess = pipeline->CanProcessInteractionEvent(eventData, distance2);
+    if (canProcess)
+    {
+      widgetState = pipeline->GetWidgetState();
+      renderLayer = pipeline->GetRenderLayer();
+    }
+  }
+
+  EvaluateCanProcessBatches(eventData);
+
+  // Evaluate the thread-safe pipelines in parallel.
+  // Each pipeline writes to its own result slot so that the merge order doesn't depend on the scheduling.
+  auto evaluateThreadSafe = [this, eventData](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      size_t iPipeline = m_threadSafeIndices[i];
+      auto& result = m_canProcessResults[iPipeline];
+      std::get<0>(result) = m_pipelines[iPipeline]->CanProcessInteractionEvent(eventData, std::get<1>(result));
+    }
+  };
+
+  const auto nThreadSafe = static_cast<vtkIdType>(m_threadSafeIndices.size());
+  if (m_isParallelEvaluation)
+  {
+    vtkSMPTools::For(0, nThreadSafe, evaluateThreadSafe);
+  }
+  else
+  {
+    evaluateThreadSafe(0, nThreadSafe);
+  }
+
+  // Only CanProcessInteractionEvent is guaranteed thread-safe, the priority is queried on the calling thread
+  for (size_t iPipeline : m_threadSafeIndices)
+  {
+    auto& [canProcess, distance2, widgetState, renderLayer] = m_canProcessResults[iPipeline];
+    if (canProcess)
+    {
+      widgetState = m_pipelines[iPipeline]->GetWidgetState();
+      renderLayer = m_pipelines[iPipeline]->GetRenderLayer();
+    }
+  }
+}
+
+void vtkMRMLLayerDMInteractionLogic::EvaluateCanProcessBatches(vtkMRMLInteractionEventData* eventData)
+{
+  // Each batch is evaluated by its first pipeline in a single call (e.g. a single GIL section for scripted pipelines)
+  for (const auto& [batchKey, indices] : m_batchIndices)
+  {
+    if (indices.empty())
+    {
+      continue;
+    }
+
+    m_batchPipelines.clear();
+    for (size_t iPipeline : indices)
+    {
+      m_batchPipelines.emplace_back(m_pipelines[iPipeline]);
+    }
+
+    m_batchResults.clear();
+    m_batchPipelines.front()->CanProcessInteractionEventBatch(m_batchPipelines, eventData, m_batchResults);
+    for (size_t iBatch = 0; iBatch < std::min(indices.size(), m_batchResults.size()); ++iBatch)
+    {
+      m_canProcessResults[indices[iBatch]] = m_batchResults[iBatch];
+    }
+  }
+}
+
 std::tuple<double, int> vtkMRMLLayerDMInteractionLogic::PrioritizeCanProcessPipelines(vtkMRMLInteractionEventData* eventData)
 {
+  EvaluateCanProcessPipelines(eventData);
+
   // For each pipeline, if pipeline can process, store its state value, layer and distance to interaction
   std::map<vtkMRMLLayerDMPipelineI*, std::tuple<int, unsigned int, double>> priority;
   double minDistance = std::numeric_limits<double>::max();
   int maxState = MinWidgetState();
-  for (const auto& pipeline : m_pipelines)
+  for (size_t iPipeline = 0; iPipeline < m_pipelines.size(); ++iPipeline)
   {
-    double pipelineDistance = std::numeric_limits<double>::max();
-    if (pipeline->CanProcessInteractionEvent(eventData, pipelineDistance))
+    const auto& pipeline = m_pipelines[iPipeline];
+    const auto& [canProcess, pipelineDistance, pipelineWidgetState, renderLayer] = m_canProcessResults[iPipeline];
+    if (canProcess)
     {
       m_canProcess.emplace_back(pipeline);
-      int widgetState = std::max(MinWidgetState(), pipeline->GetWidgetState());
+      int widgetState = std::max(MinWidgetState(), pipelineWidgetState);
       minDistance = std::min(minDistance, pipelineDistance);
       maxState = std::max(widgetState, maxState);
-      priority[pipeline] = std::make_tuple(widgetState, pipeline->GetRenderLayer(), -pipelineDistance);
+      priority[pipeline] = std::make_tuple(widgetState, renderLayer, -pipelineDistance);
     }
   }
   // Sort can process by layer order and inverted square distance (larger layer number first and closest to interaction)
-  std::sort(m_canProcess.begin(),
-            m_canProcess.end(),
-            [&priority](const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& a, const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& b) { return priority[a] > priority[b]; });
+  // Stable sort keeps the pipeline insertion order for equal priorities.
+  std::stable_sort(m_canProcess.begin(),
+                   m_canProcess.end(),
+                   [&priority](const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& a, const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& b) { return priority[a] > priority[b]; });
 
   return std::make_tuple(minDistance, maxState);
 }
@@ -102,6 +267,46 @@ void vtkMRMLLayerDMInteractionLogic::RemovePipeline(const vtkSmartPointer<vtkMRM
 }
 
 bool vtkMRMLLayerDMInteractionLogic::CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2)
+{
+  // Coalesced hover events reuse the latest dispatched results without calling the pipelines
+  m_isLastEventCoalesced = ShouldCoalesceHoverEvent(eventData);
+  if (m_isLastEventCoalesced)
+  {
+    if (!m_pendingHoverEvent)
+    {
+      m_pendingHoverEvent = vtkSmartPointer<vtkMRMLInteractionEventData>::New();
+    }
+    CopyEventData(eventData, m_pendingHoverEvent);
+    distance2 = m_lastDistance2;
+    return m_lastCanProcess;
+  }
+
+  // Any dispatched event supersedes the pending hover event.
+  // Hover detection queries the focused pipeline widget state and is only needed when coalescing.
+  m_pendingHoverEvent = nullptr;
+  if (m_isHoverCoalescing && IsHoverEvent(eventData))
+  {
+    m_isHoverDispatchedSinceRender = true;
+    m_lastHoverDispatchTime = std::chrono::steady_clock::now();
+  }
+
+  m_lastCanProcess = DispatchCanProcessInteractionEvent(eventData, distance2);
+  m_lastDistance2 = distance2;
+  return m_lastCanProcess;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::ProcessInteractionEvent(vtkMRMLInteractionEventData* eventData)
+{
+  if (m_isLastEventCoalesced)
+  {
+    return m_lastDidProcess;
+  }
+
+  m_lastDidProcess = DispatchProcessInteractionEvent(eventData);
+  return m_lastDidProcess;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::DispatchCanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2)
 {
   // Clear previous interaction list
   m_canProcess.clear();
@@ -113,6 +318,9 @@ bool vtkMRMLLayerDMInteractionLogic::CanProcessInteractionEvent(vtkMRMLInteracti
     return false;
   }
 
+  // Share the renderers projection state with the pipelines for the current event
+  ResetInteractionContexts(eventData);
+
   // Refresh the can process pipelines and order them by priority
   auto [minDistance, maxState] = PrioritizeCanProcessPipelines(eventData);
 
@@ -125,7 +333,7 @@ bool vtkMRMLLayerDMInteractionLogic::CanProcessInteractionEvent(vtkMRMLInteracti
   return !m_canProcess.empty();
 }
 
-bool vtkMRMLLayerDMInteractionLogic::ProcessInteractionEvent(vtkMRMLInteractionEventData* eventData)
+bool vtkMRMLLayerDMInteractionLogic::DispatchProcessInteractionEvent(vtkMRMLInteractionEventData* eventData)
 {
   for (const auto& pipeline : m_canProcess)
   {
@@ -144,4 +352,149 @@ bool vtkMRMLLayerDMInteractionLogic::ProcessInteractionEvent(vtkMRMLInteractionE
   // If no pipeline was able to process interaction, lose focus
   LoseFocus(eventData);
   return false;
-}
\ No newline at end of file
+}
+
+void vtkMRMLLayerDMInteractionLogic::DispatchPendingHoverEvent()
+{
+  if (!m_pendingHoverEvent)
+  {
+    return;
+  }
+
+  // Release the pending event before dispatch in case the pipelines trigger new interactions
+  vtkSmartPointer<vtkMRMLInteractionEventData> eventData = m_pendingHoverEvent;
+  m_pendingHoverEvent = nullptr;
+  m_isHoverDispatchedSinceRender = true;
+  m_lastHoverDispatchTime = std::chrono::steady_clock::now();
+
+  double distance2 = std::numeric_limits<double>::max();
+  m_lastCanProcess = DispatchCanProcessInteractionEvent(eventData, distance2);
+  m_lastDistance2 = distance2;
+  m_lastDidProcess = m_lastCanProcess && DispatchProcessInteractionEvent(eventData);
+}
+
+void vtkMRMLLayerDMInteractionLogic::SetHoverCoalescing(bool isEnabled)
+{
+  m_isHoverCoalescing = isEnabled;
+  if (!m_isHoverCoalescing)
+  {
+    m_pendingHoverEvent = nullptr;
+    m_isLastEventCoalesced = false;
+  }
+}
+
+bool vtkMRMLLayerDMInteractionLogic::GetHoverCoalescing() const
+{
+  return m_isHoverCoalescing;
+}
+
+void vtkMRMLLayerDMInteractionLogic::SetParallelEvaluation(bool isEnabled)
+{
+  m_isParallelEvaluation = isEnabled;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::GetParallelEvaluation() const
+{
+  return m_isParallelEvaluation;
+}
+
+void vtkMRMLLayerDMInteractionLogic::SetMaxHoverDispatchRate(double eventsPerSecond)
+{
+  m_maxHoverDispatchRate = eventsPerSecond;
+}
+
+double vtkMRMLLayerDMInteractionLogic::GetMaxHoverDispatchRate() const
+{
+  return m_maxHoverDispatchRate;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::HasPendingHoverEvent() const
+{
+  return m_pendingHoverEvent != nullptr;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::IsRenderPending() const
+{
+  return m_isRenderPending;
+}
+
+void vtkMRMLLayerDMInteractionLogic::OnRenderRequested()
+{
+  m_isRenderPending = true;
+}
+
+void vtkMRMLLayerDMInteractionLogic::OnRenderFinished()
+{
+  m_isRenderPending = false;
+  m_isHoverDispatchedSinceRender = false;
+  DispatchPendingHoverEvent();
+}
+
+bool vtkMRMLLayerDMInteractionLogic::IsHoverEvent(vtkMRMLInteractionEventData* eventData) const
+{
+  if (!eventData || eventData->GetType() != vtkCommand::MouseMoveEvent)
+  {
+    return false;
+  }
+
+  // Mouse moves during an active widget interaction (dragging) are never considered hover events
+  return !m_prevFocusedPipeline || m_prevFocusedPipeline->GetWidgetState() <= MinWidgetState();
+}
+
+bool vtkMRMLLayerDMInteractionLogic::IsHoverRateLimited() const
+{
+  if (m_maxHoverDispatchRate <= 0)
+  {
+    return false;
+  }
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_lastHoverDispatchTime;
+  return elapsed.count() < 1.0 / m_maxHoverDispatchRate;
+}
+
+bool vtkMRMLLayerDMInteractionLogic::ShouldCoalesceHoverEvent(vtkMRMLInteractionEventData* eventData) const
+{
+  if (!m_isHoverCoalescing || !IsHoverEvent(eventData))
+  {
+    return false;
+  }
+
+  return (m_isRenderPending && m_isHoverDispatchedSinceRender) || IsHoverRateLimited();
+}
+
+void vtkMRMLLayerDMInteractionLogic::CopyEventData(vtkMRMLInteractionEventData* source, vtkMRMLInteractionEventData* target)
+{
+  target->SetType(source->GetType());
+  target->SetModifiers(source->GetModifiers());
+  target->SetKeyCode(source->GetKeyCode());
+  target->SetKeySym(source->GetKeySym());
+  target->SetKeyRepeatCount(source->GetKeyRepeatCount());
+  target->SetComponentType(source->GetComponentType());
+  target->SetComponentIndex(source->GetComponentIndex());
+  target->SetWorldToPhysicalScale(source->GetWorldToPhysicalScale());
+  target->SetViewNode(source->GetViewNode());
+  target->SetRenderer(source->GetRenderer());
+  target->SetAccuratePicker(source->GetAccuratePicker());
+  target->SetMouseMovedSinceButtonDown(source->GetMouseMovedSinceButtonDown());
+  target->SetInteractionContextName(source->GetInteractionContextName());
+
+  if (source->IsDisplayPositionValid())
+  {
+    target->SetDisplayPosition(source->GetDisplayPosition());
+  }
+  else
+  {
+    target->SetDisplayPositionInvalid();
+  }
+
+  if (source->IsWorldPositionValid())
+  {
+    double worldPosition[3];
+    source->GetWorldPosition(worldPosition);
+    target->SetWorldPosition(worldPosition, source->IsWorldPositionAccurate());
+  }
+  else
+  {
+    target->SetWorldPositionInvalid();
+  }
+}
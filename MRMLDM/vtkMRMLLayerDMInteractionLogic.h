@@ -6,11 +6,16 @@
 #include <vtkWeakPointer.h>
 #include <vtkSmartPointer.h>
 
+#include <chrono>
+#include <map>
+#include <mutex>
 #include <vector>
 
+class vtkMRMLLayerDMInteractionContext;
 class vtkMRMLLayerDMPipelineI;
 class vtkMRMLInteractionEventData;
 class vtkMRMLAbstractViewNode;
+class vtkRenderer;
 
 /// \brief Pipeline manager interaction logic class
 ///
@@ -21,6 +26,20 @@ class vtkMRMLAbstractViewNode;
 ///   - Widget State if state is greater than WidgetStateOnWidget (indicates previously active display pipeline)
 ///   - Pipeline layer (higher = overlay on top of other renderers)
 ///   - Distance to interaction (min = closer to VTK event)
+///
+/// Pipelines declaring a thread-safe \sa vtkMRMLLayerDMPipelineI::CanProcessInteractionEvent are evaluated in parallel
+/// using vtkSMPTools. Other pipelines are evaluated on the calling thread. Pipelines with equal priorities keep their
+/// insertion order.
+///
+/// The \sa vtkMRMLLayerDMInteractionContext of a renderer is built on the first \sa GetInteractionContext call of each
+/// event and reused by the other pipelines of the renderer during the event processing. Renderers whose pipelines don't
+/// use the context don't build it.
+///
+/// Optionally, hover events (mouse move events outside of an active widget interaction) can be coalesced.
+/// When coalescing is enabled, hover events received while a render is pending or faster than the max hover dispatch
+/// rate are not dispatched to the pipelines. Only the latest of these hover events is kept and dispatched on the next
+/// \sa OnRenderFinished call. Button and key events are never coalesced. When coalescing is disabled, the events are
+/// dispatched without querying the focused pipeline widget state.
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMInteractionLogic : public vtkObject
 {
 public:
@@ -30,24 +49,118 @@ public:
   void AddPipeline(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline);
   bool CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2);
   std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> GetCanProcessPipelines() const;
+
+  /// @{
+  /// Pipelines able to process the last event, sorted by priority. Python friendly access to \sa GetCanProcessPipelines.
+  int GetNumberOfCanProcessPipelines() const;
+  vtkMRMLLayerDMPipelineI* GetCanProcessPipeline(int index) const;
+  /// @}
   vtkMRMLLayerDMPipelineI* GetLastFocusedPipeline() const;
+
+  /// Returns the interaction context of the input renderer for the event being processed.
+  /// The context is updated on the first call of each event. Thread-safe.
+  /// nullptr if the renderer is nullptr or if no event was processed yet.
+  vtkMRMLLayerDMInteractionContext* GetInteractionContext(vtkRenderer* renderer) const;
   void LoseFocus(vtkMRMLInteractionEventData* eventData);
   void LoseFocus();
   bool ProcessInteractionEvent(vtkMRMLInteractionEventData* eventData);
   void RemovePipeline(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline);
   void SetViewNode(vtkMRMLAbstractViewNode* viewNode);
 
+  /// @{
+  /// Enable / disable hover event coalescing. Disabled by default.
+  void SetHoverCoalescing(bool isEnabled);
+  bool GetHoverCoalescing() const;
+  /// @}
+
+  /// @{
+  /// Maximum number of hover events dispatched to the pipelines per second when hover coalescing is enabled.
+  /// Values <= 0 disable the rate limit (default).
+  void SetMaxHoverDispatchRate(double eventsPerSecond);
+  double GetMaxHoverDispatchRate() const;
+  /// @}
+
+  /// @{
+  /// Evaluate the thread-safe pipelines in parallel using vtkSMPTools. Enabled by default.
+  /// When disabled, the thread-safe pipelines are evaluated on the calling thread. The selected pipelines are the same.
+  void SetParallelEvaluation(bool isEnabled);
+  bool GetParallelEvaluation() const;
+  /// @}
+
+  /// true if a hover event was coalesced and is waiting for the next \sa OnRenderFinished call.
+  bool HasPendingHoverEvent() const;
+
+  /// true if a render was requested and is not finished yet.
+  bool IsRenderPending() const;
+
+  /// Notify the logic that a render was requested.
+  /// While the render is pending, only the first hover event is dispatched to the pipelines.
+  void OnRenderRequested();
+
+  /// Notify the logic that the render is finished.
+  /// Dispatches the latest coalesced hover event if any.
+  void OnRenderFinished();
+
 protected:
   vtkMRMLLayerDMInteractionLogic();
   ~vtkMRMLLayerDMInteractionLogic() override = default;
 
 private:
   static int MinWidgetState();
+
+  /// Copy the coalesced hover event into the pending event.
+  /// Only mouse move events are coalesced: the gesture (rotation, scale, translation) and the 3D device (orientation,
+  /// direction) fields of the event are not set for them and are not copied.
+  static void CopyEventData(vtkMRMLInteractionEventData* source, vtkMRMLInteractionEventData* target);
   std::tuple<double, int> PrioritizeCanProcessPipelines(vtkMRMLInteractionEventData* eventData);
+  void EvaluateCanProcessPipelines(vtkMRMLInteractionEventData* eventData);
+  void EvaluateCanProcessBatches(vtkMRMLInteractionEventData* eventData);
+  void ResetInteractionContexts(vtkMRMLInteractionEventData* eventData);
   void LosePreviousFocusInCannotProcess(vtkMRMLInteractionEventData* eventData);
+  bool DispatchCanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2);
+  bool DispatchProcessInteractionEvent(vtkMRMLInteractionEventData* eventData);
+  void DispatchPendingHoverEvent();
+  bool IsHoverEvent(vtkMRMLInteractionEventData* eventData) const;
+  bool IsHoverRateLimited() const;
+  bool ShouldCoalesceHoverEvent(vtkMRMLInteractionEventData* eventData) const;
 
   std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> m_pipelines;
   vtkSmartPointer<vtkMRMLLayerDMPipelineI> m_prevFocusedPipeline;
   std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> m_canProcess;
   vtkWeakPointer<vtkMRMLAbstractViewNode> m_viewNode;
+
+  // Per pipeline can process result, distance, widget state and render layer, indexed as m_pipelines
+  std::vector<vtkMRMLLayerDMPipelineI::CanProcessResult> m_canProcessResults;
+  std::vector<size_t> m_threadSafeIndices;
+
+  // Per batch key pipeline indices, evaluated with a single batch call per event
+  std::map<const void*, std::vector<size_t>> m_batchIndices;
+  std::vector<vtkMRMLLayerDMPipelineI*> m_batchPipelines;
+  std::vector<vtkMRMLLayerDMPipelineI::CanProcessResult> m_batchResults;
+
+  // Interaction context per renderer, built on demand once per event. Guarded by the mutex as the thread-safe pipelines
+  // may request their context concurrently.
+  struct ContextEntry
+  {
+    vtkSmartPointer<vtkMRMLLayerDMInteractionContext> Context;
+    unsigned long EventIndex{ 0 };
+  };
+  mutable std::map<vtkWeakPointer<vtkRenderer>, ContextEntry> m_contexts;
+  mutable std::mutex m_contextsMutex;
+  vtkSmartPointer<vtkMRMLInteractionEventData> m_contextEventData;
+  unsigned long m_contextEventIndex;
+
+  bool m_isParallelEvaluation;
+
+  // Hover coalescing state
+  bool m_isHoverCoalescing;
+  double m_maxHoverDispatchRate;
+  bool m_isRenderPending;
+  bool m_isHoverDispatchedSinceRender;
+  bool m_isLastEventCoalesced;
+  bool m_lastCanProcess;
+  bool m_lastDidProcess;
+  double m_lastDistance2;
+  vtkSmartPointer<vtkMRMLInteractionEventData> m_pendingHoverEvent;
+  std::chrono::steady_clock::time_point m_lastHoverDispatchTime;
 };
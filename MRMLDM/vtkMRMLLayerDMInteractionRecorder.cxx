@@ -0,0 +1,293 @@
+#include "vtkMRMLLayerDMInteractionRecorder.h"
+
+#include "vtkMRMLLayerDMPipelineI.h"
+#include "vtkMRMLLayerDMPipelineManager.h"
+
+#include <vtkByteSwap.h>
+#include <vtkMRMLInteractionEventData.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkRenderer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+vtkStandardNewMacro(vtkMRMLLayerDMInteractionRecorder);
+
+namespace
+{
+constexpr std::array<char, 4> FileMagic = { 'L', 'D', 'M', 'I' };
+constexpr std::uint32_t FileVersion = 2;
+
+enum EventFlags : std::uint8_t
+{
+  DisplayPositionValid = 1 << 0,
+  WorldPositionValid = 1 << 1,
+  WorldPositionAccurate = 1 << 2
+};
+
+/// Values are stored in little endian order regardless of the platform endianness.
+template <typename T>
+void Write(std::ostream& stream, T value)
+{
+  vtkByteSwap::SwapLE(&value);
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T, size_t N>
+void Write(std::ostream& stream, const std::array<T, N>& values)
+{
+  for (const T& value : values)
+  {
+    Write(stream, value);
+  }
+}
+
+template <typename T>
+bool Read(std::istream& stream, T& value)
+{
+  if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+  {
+    return false;
+  }
+  vtkByteSwap::SwapLE(&value);
+  return true;
+}
+
+template <typename T, size_t N>
+bool Read(std::istream& stream, std::array<T, N>& values)
+{
+  return std::all_of(values.begin(), values.end(), [&stream](T& value) { return Read(stream, value); });
+}
+
+/// Read the next recorded event in the input event data.
+bool ReadEvent(std::istream& stream, vtkMRMLInteractionEventData* eventData)
+{
+  double time;
+  std::uint32_t type;
+  std::int32_t modifiers;
+  std::array<std::int32_t, 2> displayPosition;
+  std::array<double, 3> worldPosition;
+  std::uint8_t flags;
+  std::int8_t keyCode;
+  std::uint8_t keySymLength;
+  if (!Read(stream, time) || !Read(stream, type) || !Read(stream, modifiers) || !Read(stream, displayPosition) || !Read(stream, worldPosition)
+      || !Read(stream, flags) || !Read(stream, keyCode) || !Read(stream, keySymLength))
+  {
+    return false;
+  }
+
+  std::string keySym(keySymLength, '\0');
+  if (keySymLength > 0 && !stream.read(keySym.data(), keySymLength))
+  {
+    return false;
+  }
+
+  eventData->SetType(type);
+  eventData->SetModifiers(modifiers);
+  eventData->SetKeyCode(static_cast<char>(keyCode));
+  eventData->SetKeySym(keySym);
+
+  if (flags & DisplayPositionValid)
+  {
+    const int position[2] = { displayPosition[0], displayPosition[1] };
+    eventData->SetDisplayPosition(position);
+  }
+  else
+  {
+    eventData->SetDisplayPositionInvalid();
+  }
+
+  if (flags & WorldPositionValid)
+  {
+    eventData->SetWorldPosition(worldPosition.data(), flags & WorldPositionAccurate);
+  }
+  else
+  {
+    eventData->SetWorldPositionInvalid();
+  }
+  return true;
+}
+} // namespace
+
+vtkMRMLLayerDMInteractionRecorder::vtkMRMLLayerDMInteractionRecorder()
+  : m_recordStream{}
+  , m_recordStart{}
+  , m_nRecordedEvents{ 0 }
+  , m_nReplayedEvents{ 0 }
+  , m_nFocusChanges{ 0 }
+  , m_canProcessLatencies{}
+  , m_processLatencies{}
+{
+}
+
+vtkMRMLLayerDMInteractionRecorder::~vtkMRMLLayerDMInteractionRecorder()
+{
+  StopRecording();
+}
+
+bool vtkMRMLLayerDMInteractionRecorder::StartRecording(const std::string& filePath)
+{
+  StopRecording();
+  m_recordStream.open(filePath, std::ios::binary | std::ios::trunc);
+  if (!m_recordStream)
+  {
+    vtkErrorMacro("" << __func__ << ": Failed to open file for writing : " << filePath);
+    return false;
+  }
+
+  Write(m_recordStream, FileMagic);
+  Write(m_recordStream, FileVersion);
+  m_recordStart = std::chrono::steady_clock::now();
+  m_nRecordedEvents = 0;
+  return true;
+}
+
+void vtkMRMLLayerDMInteractionRecorder::StopRecording()
+{
+  if (m_recordStream.is_open())
+  {
+    m_recordStream.close();
+  }
+}
+
+bool vtkMRMLLayerDMInteractionRecorder::IsRecording() const
+{
+  return m_recordStream.is_open();
+}
+
+void vtkMRMLLayerDMInteractionRecorder::RecordEvent(vtkMRMLInteractionEventData* eventData)
+{
+  if (!eventData || !IsRecording())
+  {
+    return;
+  }
+
+  const std::chrono::duration<double> time = std::chrono::steady_clock::now() - m_recordStart;
+
+  std::array<std::int32_t, 2> displayPosition{};
+  std::array<double, 3> worldPosition{};
+  std::uint8_t flags = 0;
+  if (eventData->IsDisplayPositionValid())
+  {
+    flags |= DisplayPositionValid;
+    const int* position = eventData->GetDisplayPosition();
+    displayPosition = { position[0], position[1] };
+  }
+  if (eventData->IsWorldPositionValid())
+  {
+    flags |= WorldPositionValid;
+    flags |= eventData->IsWorldPositionAccurate() ? WorldPositionAccurate : 0;
+    eventData->GetWorldPosition(worldPosition.data());
+  }
+
+  std::string keySym = eventData->GetKeySym();
+  keySym.resize(std::min<size_t>(keySym.size(), 255));
+
+  Write(m_recordStream, time.count());
+  Write(m_recordStream, static_cast<std::uint32_t>(eventData->GetType()));
+  Write(m_recordStream, static_cast<std::int32_t>(eventData->GetModifiers()));
+  Write(m_recordStream, displayPosition);
+  Write(m_recordStream, worldPosition);
+  Write(m_recordStream, flags);
+  Write(m_recordStream, static_cast<std::int8_t>(eventData->GetKeyCode()));
+  Write(m_recordStream, static_cast<std::uint8_t>(keySym.size()));
+  m_recordStream.write(keySym.data(), static_cast<std::streamsize>(keySym.size()));
+  m_nRecordedEvents++;
+}
+
+int vtkMRMLLayerDMInteractionRecorder::GetNumberOfRecordedEvents() const
+{
+  return m_nRecordedEvents;
+}
+
+bool vtkMRMLLayerDMInteractionRecorder::Replay(const std::string& filePath, vtkMRMLLayerDMPipelineManager* pipelineManager, vtkRenderer* renderer)
+{
+  m_nReplayedEvents = 0;
+  m_nFocusChanges = 0;
+  m_canProcessLatencies.clear();
+  m_processLatencies.clear();
+
+  if (!pipelineManager)
+  {
+    vtkErrorMacro("" << __func__ << ": Pipeline manager is invalid.");
+    return false;
+  }
+
+  std::ifstream stream(filePath, std::ios::binary);
+  std::array<char, 4> magic{};
+  std::uint32_t version = 0;
+  if (!stream || !Read(stream, magic) || magic != FileMagic || !Read(stream, version) || version != FileVersion)
+  {
+    vtkErrorMacro("" << __func__ << ": Invalid interaction recording : " << filePath);
+    return false;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  vtkNew<vtkMRMLInteractionEventData> eventData;
+  eventData->SetViewNode(pipelineManager->GetViewNode());
+  eventData->SetRenderer(renderer);
+  vtkMRMLLayerDMPipelineI* prevFocused = pipelineManager->GetLastFocusedPipeline();
+  while (ReadEvent(stream, eventData))
+  {
+    double distance2 = VTK_DOUBLE_MAX;
+    auto start = Clock::now();
+    bool canProcess = pipelineManager->CanProcessInteractionEvent(eventData, distance2);
+    m_canProcessLatencies.emplace_back(Milliseconds(Clock::now() - start).count());
+
+    if (canProcess)
+    {
+      start = Clock::now();
+      pipelineManager->ProcessInteractionEvent(eventData);
+      m_processLatencies.emplace_back(Milliseconds(Clock::now() - start).count());
+    }
+
+    vtkMRMLLayerDMPipelineI* focused = pipelineManager->GetLastFocusedPipeline();
+    if (focused != prevFocused)
+    {
+      m_nFocusChanges++;
+      prevFocused = focused;
+    }
+    m_nReplayedEvents++;
+  }
+  return true;
+}
+
+int vtkMRMLLayerDMInteractionRecorder::GetNumberOfReplayedEvents() const
+{
+  return m_nReplayedEvents;
+}
+
+double vtkMRMLLayerDMInteractionRecorder::GetCanProcessLatencyPercentile(double percentile) const
+{
+  return ComputePercentile(m_canProcessLatencies, percentile);
+}
+
+double vtkMRMLLayerDMInteractionRecorder::GetProcessLatencyPercentile(double percentile) const
+{
+  return ComputePercentile(m_processLatencies, percentile);
+}
+
+int vtkMRMLLayerDMInteractionRecorder::GetNumberOfFocusChanges() const
+{
+  return m_nFocusChanges;
+}
+
+double vtkMRMLLayerDMInteractionRecorder::ComputePercentile(std::vector<double> values, double percentile)
+{
+  if (values.empty())
+  {
+    return 0;
+  }
+
+  // Nearest rank percentile
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(values.size())));
+  const size_t index = rank > 0 ? rank - 1 : 0;
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
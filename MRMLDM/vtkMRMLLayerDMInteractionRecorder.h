@@ -0,0 +1,91 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkObject.h>
+#include <vtkWrappingHints.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class vtkMRMLInteractionEventData;
+class vtkMRMLLayerDMPipelineManager;
+class vtkRenderer;
+
+/// \brief Records and replays the interaction events going through a \sa vtkMRMLLayerDMPipelineManager.
+///
+/// When set on a pipeline manager using \sa vtkMRMLLayerDMPipelineManager::SetInteractionRecorder, every event
+/// received by \sa vtkMRMLLayerDMPipelineManager::CanProcessInteractionEvent is serialized to a compact binary file.
+///
+/// Recorded files can be replayed against a pipeline manager (for instance the pipeline manager of a view displaying
+/// a saved scene) to measure the interaction latency in a deterministic way. For each replayed event, the
+/// CanProcessInteractionEvent and ProcessInteractionEvent phases are timed and the focused pipeline changes are counted.
+///
+/// Binary format (little endian, independent of the platform endianness) :
+///   - Header : "LDMI" magic, uint32 version
+///   - Per event : double time since recording start (s), uint32 type, int32 modifiers, int32 display position[2],
+///     double world position[3], uint8 flags (display valid, world valid, world accurate), int8 key code,
+///     uint8 key sym length followed by the key sym characters
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMInteractionRecorder : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMInteractionRecorder* New();
+  vtkTypeMacro(vtkMRMLLayerDMInteractionRecorder, vtkObject);
+
+  /// Start recording to the input file path.
+  /// Previous file content is overwritten.
+  /// \return false if the file cannot be opened.
+  bool StartRecording(const std::string& filePath);
+
+  /// Stop the current recording and flush the file.
+  void StopRecording();
+
+  /// true if a recording is in progress.
+  bool IsRecording() const;
+
+  /// Serialize the input event to the current recording.
+  /// Does nothing if not recording.
+  void RecordEvent(vtkMRMLInteractionEventData* eventData);
+
+  /// Number of events recorded since the last \sa StartRecording.
+  int GetNumberOfRecordedEvents() const;
+
+  /// Replay the recorded file against the input pipeline manager.
+  /// Each event is sent to CanProcessInteractionEvent and, if it can be processed, to ProcessInteractionEvent.
+  /// The replayed events are attached to the input renderer (usually the renderer of the view displayable manager).
+  /// If nullptr, the replayed events carry no renderer and the pipelines relying on it will not process them.
+  /// The python GIL is released during the replay and acquired again by the scripted pipelines when called.
+  /// \return false if the file cannot be read or the pipeline manager is nullptr.
+  VTK_UNBLOCKTHREADS bool Replay(const std::string& filePath, vtkMRMLLayerDMPipelineManager* pipelineManager, vtkRenderer* renderer = nullptr);
+
+  /// Number of events sent during the last \sa Replay.
+  int GetNumberOfReplayedEvents() const;
+
+  /// @{
+  /// Latency percentile in ms of the CanProcessInteractionEvent and ProcessInteractionEvent phases of the last replay.
+  /// \param percentile: Value in [0, 100] (for instance 50 for p50, 99 for p99)
+  double GetCanProcessLatencyPercentile(double percentile) const;
+  double GetProcessLatencyPercentile(double percentile) const;
+  /// @}
+
+  /// Number of times the focused pipeline changed during the last \sa Replay.
+  int GetNumberOfFocusChanges() const;
+
+protected:
+  vtkMRMLLayerDMInteractionRecorder();
+  ~vtkMRMLLayerDMInteractionRecorder() override;
+
+private:
+  static double ComputePercentile(std::vector<double> values, double percentile);
+
+  std::ofstream m_recordStream;
+  std::chrono::steady_clock::time_point m_recordStart;
+  int m_nRecordedEvents;
+
+  int m_nReplayedEvents;
+  int m_nFocusChanges;
+  std::vector<double> m_canProcessLatencies;
+  std::vector<double> m_processLatencies;
+};
@@ -8,6 +8,9 @@
 #include <vtkObjectFactory.h>
 #include <vtkRendererCollection.h>
 #include <vtkBoundingBox.h>
+#include <vtkMath.h>
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkMRMLLayerDMLayerManager);
 
@@ -70,19 +73,78 @@ void vtkMRMLLayerDMLayerManager::RemovePipeline(vtkMRMLLayerDMPipelineI* pipelin
 
 void vtkMRMLLayerDMLayerManager::ResetCameraClippingRange() const
 {
-  // Reset first renderer clipping range
-  if (auto defaultRenderer = GetDefaultRenderer())
+  ResetCameraClippingRange(nullptr);
+}
+
+void vtkMRMLLayerDMLayerManager::ResetCameraClippingRange(const double defaultCameraRange[2]) const
+{
+  // Managed renderers sharing the first renderer camera are reset together with the first renderer
+  auto defaultRenderer = GetDefaultRenderer();
+  vtkCamera* sharedCamera = (defaultRenderer && defaultRenderer->IsActiveCameraCreated()) ? defaultRenderer->GetActiveCamera() : nullptr;
+  auto sharedRenderers = m_cameraRendererMap.find(sharedCamera);
+  if (sharedCamera && sharedRenderers != m_cameraRendererMap.end())
   {
+    auto renderers = sharedRenderers->second;
+    renderers.emplace(defaultRenderer);
+    ResetRenderersCameraClippingRange(renderers, ComputeRenderersVisibleBounds(renderers));
+  }
+  else if (defaultRenderer)
+  {
+    // Reset first renderer clipping range
     defaultRenderer->ResetCameraClippingRange();
   }
 
   // Reset the managed renderers grouped by common cameras
   for (const auto& pair : m_cameraRendererMap)
   {
+    if (sharedCamera && pair.first == sharedCamera)
+    {
+      continue;
+    }
+
+    if (defaultCameraRange && pair.first.GetPointer() == m_defaultCamera.GetPointer())
+    {
+      if (!std::equal(defaultCameraRange, defaultCameraRange + 2, m_defaultCamera->GetClippingRange()))
+      {
+        m_defaultCamera->SetClippingRange(defaultCameraRange);
+      }
+      continue;
+    }
     ResetRenderersCameraClippingRange(pair.second, ComputeRenderersVisibleBounds(pair.second));
   }
 }
 
+void vtkMRMLLayerDMLayerManager::ComputeDefaultCameraVisibleBounds(double bounds[6]) const
+{
+  vtkMath::UninitializeBounds(bounds);
+  auto found = m_cameraRendererMap.find(m_defaultCamera.GetPointer());
+  if (found != m_cameraRendererMap.end())
+  {
+    auto visibleBounds = ComputeRenderersVisibleBounds(found->second);
+    std::copy(visibleBounds.begin(), visibleBounds.end(), bounds);
+  }
+}
+
+bool vtkMRMLLayerDMLayerManager::ResetDefaultCameraClippingRange(const double bounds[6]) const
+{
+  auto found = m_cameraRendererMap.find(m_defaultCamera.GetPointer());
+  if (found == m_cameraRendererMap.end())
+  {
+    return false;
+  }
+
+  // Renderers share the camera, resetting one of them is enough
+  for (const auto& renderer : found->second)
+  {
+    if (renderer)
+    {
+      renderer->ResetCameraClippingRange(bounds);
+      return true;
+    }
+  }
+  return false;
+}
+
 void vtkMRMLLayerDMLayerManager::SetRenderWindow(vtkRenderWindow* renderWindow)
 {
   if (m_renderWindow == renderWindow)
@@ -105,6 +167,40 @@ void vtkMRMLLayerDMLayerManager::SetDefaultCamera(const vtkSmartPointer<vtkCamer
   UpdateLayers();
 }
 
+void vtkMRMLLayerDMLayerManager::UpdatePipelineLayer(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  if (!pipeline)
+  {
+    return;
+  }
+
+  auto key = GetPipelineLayerKey(pipeline);
+  if (ContainsLayerKey(key) && m_pipelineLayers[key].count(pipeline))
+  {
+    return;
+  }
+
+  // Remove the pipeline from its previous layer
+  bool isFound = false;
+  for (auto it = m_pipelineLayers.begin(); it != m_pipelineLayers.end();)
+  {
+    if (it->second.erase(pipeline))
+    {
+      isFound = true;
+    }
+    it = it->second.empty() ? m_pipelineLayers.erase(it) : std::next(it);
+  }
+
+  // Pipelines not managed by the layer manager are ignored
+  if (!isFound)
+  {
+    return;
+  }
+
+  m_pipelineLayers[key].emplace(pipeline);
+  UpdateLayers();
+}
+
 vtkMRMLLayerDMLayerManager::vtkMRMLLayerDMLayerManager()
   : m_emptyPipeline(vtkSmartPointer<vtkMRMLLayerDMPipelineI>::New())
 {
@@ -4,6 +4,7 @@
 #include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
 
 #include <vtkObject.h>
+#include <vtkWrappingHints.h>
 #include <vtkWeakPointer.h>
 #include <vtkSmartPointer.h>
 #include <map>
@@ -40,10 +41,26 @@ public:
   int GetNumberOfManagedLayers() const;
   int GetNumberOfRenderers() const;
   void RemovePipeline(vtkMRMLLayerDMPipelineI* pipeline);
-  void ResetCameraClippingRange() const;
+  VTK_UNBLOCKTHREADS void ResetCameraClippingRange() const;
+
+  /// Reset the clipping range of the renderers, setting the input clipping range on the default camera instead of
+  /// computing the visible bounds of its renderers. Used when the default camera clipping range is known (slice views).
+  VTK_UNBLOCKTHREADS void ResetCameraClippingRange(const double defaultCameraRange[2]) const;
+
+  /// Visible bounds of the managed renderers rendered with the default camera.
+  /// Bounds are uninitialized if no renderer uses the default camera or no prop is visible.
+  void ComputeDefaultCameraVisibleBounds(double bounds[6]) const;
+
+  /// Reset the default camera clipping range from the input bounds.
+  /// \return false if no managed renderer uses the default camera.
+  bool ResetDefaultCameraClippingRange(const double bounds[6]) const;
   void SetRenderWindow(vtkRenderWindow* renderWindow);
   void SetDefaultCamera(const vtkSmartPointer<vtkCamera>& camera);
 
+  /// Move the input pipeline to the layer matching its current render layer and camera.
+  /// Should be called when a pipeline's layer key changes after it has been added.
+  void UpdatePipelineLayer(vtkMRMLLayerDMPipelineI* pipeline);
+
 protected:
   vtkMRMLLayerDMLayerManager();
   ~vtkMRMLLayerDMLayerManager() override = default;
@@ -0,0 +1,356 @@
+#include "vtkMRMLLayerDMObserverHub.h"
+
+#include "vtkMRMLLayerDMPipelineI.h"
+#include "vtkMRMLLayerDMPipelineManager.h"
+#include "vtkObjectEventObserver.h"
+
+#include <vtkCommand.h>
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkMRMLLayerDMObserverHub);
+
+vtkSmartPointer<vtkMRMLLayerDMObserverHub> vtkMRMLLayerDMObserverHub::GetInstance()
+{
+  static vtkSmartPointer<vtkMRMLLayerDMObserverHub> instance = vtkSmartPointer<vtkMRMLLayerDMObserverHub>::New();
+  return instance;
+}
+
+vtkMRMLLayerDMObserverHub::vtkMRMLLayerDMObserverHub()
+  : m_eventObserver(vtkSmartPointer<vtkObjectEventObserver>::New())
+  , m_objects{}
+  , m_pipelineObjects{}
+  , m_removedObjects{}
+  , m_modifiedObjects{}
+  , m_dispatchDepth{ 0 }
+{
+  m_eventObserver->SetUpdateCallback([this](vtkObject* caller, unsigned long eventId, void* callData) { Dispatch(caller, eventId, callData); });
+  m_eventObserver->SetPendingCallback([this](vtkObject* caller, unsigned long eventId) { RequestFlush(caller, eventId); });
+}
+
+vtkMRMLLayerDMObserverHub::~vtkMRMLLayerDMObserverHub() = default;
+
+bool vtkMRMLLayerDMObserverHub::Subscribe(vtkMRMLLayerDMPipelineI* pipeline, vtkObject* obj, unsigned long event)
+{
+  if (!pipeline || !obj)
+  {
+    return false;
+  }
+
+  auto& entry = m_objects[obj];
+  if (!entry)
+  {
+    entry = std::make_unique<ObjectEntry>();
+    entry->Object = obj;
+    m_eventObserver->AddEventObserver(obj, vtkCommand::DeleteEvent);
+  }
+
+  auto eventEntry = std::find_if(entry->Events.begin(), entry->Events.end(), [event](const EventEntry& e) { return e.Event == event; });
+  if (eventEntry == entry->Events.end())
+  {
+    // DeleteEvent subscribers are notified by the DeleteEvent observer of the object
+    m_eventObserver->AddEventObserver(obj, event);
+    entry->Events.push_back({ event, {} });
+    eventEntry = std::prev(entry->Events.end());
+  }
+
+  auto& subscribers = eventEntry->Subscribers;
+  if (std::find(subscribers.begin(), subscribers.end(), pipeline) != subscribers.end())
+  {
+    return false;
+  }
+  subscribers.emplace_back(pipeline);
+
+  auto& pipelineObjects = m_pipelineObjects[pipeline];
+  if (std::find(pipelineObjects.begin(), pipelineObjects.end(), obj) == pipelineObjects.end())
+  {
+    pipelineObjects.emplace_back(obj);
+  }
+  return true;
+}
+
+void vtkMRMLLayerDMObserverHub::Unsubscribe(vtkMRMLLayerDMPipelineI* pipeline, vtkObject* obj)
+{
+  if (!pipeline || !obj)
+  {
+    return;
+  }
+
+  auto pipelineObjects = m_pipelineObjects.find(pipeline);
+  if (pipelineObjects == m_pipelineObjects.end())
+  {
+    return;
+  }
+
+  auto& objects = pipelineObjects->second;
+  auto found = std::find(objects.begin(), objects.end(), obj);
+  if (found == objects.end())
+  {
+    return;
+  }
+
+  objects.erase(found);
+  if (objects.empty())
+  {
+    m_pipelineObjects.erase(pipelineObjects);
+  }
+  RemoveSubscriber(obj, pipeline);
+}
+
+void vtkMRMLLayerDMObserverHub::UnsubscribeAll(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  auto pipelineObjects = m_pipelineObjects.find(pipeline);
+  if (pipelineObjects == m_pipelineObjects.end())
+  {
+    return;
+  }
+
+  auto objects = std::move(pipelineObjects->second);
+  m_pipelineObjects.erase(pipelineObjects);
+  for (const auto& obj : objects)
+  {
+    RemoveSubscriber(obj, pipeline);
+  }
+}
+
+int vtkMRMLLayerDMObserverHub::GetNumberOfObservedObjects() const
+{
+  return static_cast<int>(m_objects.size());
+}
+
+int vtkMRMLLayerDMObserverHub::GetNumberOfObservers() const
+{
+  return m_eventObserver->GetNumberOfObservers();
+}
+
+int vtkMRMLLayerDMObserverHub::GetNumberOfSubscriptions() const
+{
+  int nSubscriptions = 0;
+  for (const auto& object : m_objects)
+  {
+    for (const auto& eventEntry : object.second->Events)
+    {
+      const auto& subscribers = eventEntry.Subscribers;
+      nSubscriptions += static_cast<int>(std::count_if(subscribers.begin(), subscribers.end(), [](vtkMRMLLayerDMPipelineI* p) { return p != nullptr; }));
+    }
+  }
+  return nSubscriptions;
+}
+
+unsigned long vtkMRMLLayerDMObserverHub::GetMemorySize() const
+{
+  // Hash map nodes are estimated as their value and two pointers
+  constexpr unsigned long nodeOverhead = 2 * sizeof(void*);
+  unsigned long memorySize = sizeof(*this);
+  for (const auto& object : m_objects)
+  {
+    memorySize += nodeOverhead + sizeof(object) + sizeof(ObjectEntry);
+    memorySize += static_cast<unsigned long>(object.second->Events.capacity() * sizeof(EventEntry));
+    for (const auto& eventEntry : object.second->Events)
+    {
+      memorySize += static_cast<unsigned long>(eventEntry.Subscribers.capacity() * sizeof(vtkMRMLLayerDMPipelineI*));
+    }
+  }
+  for (const auto& pipelineObjects : m_pipelineObjects)
+  {
+    memorySize += nodeOverhead + sizeof(pipelineObjects);
+    memorySize += static_cast<unsigned long>(pipelineObjects.second.capacity() * sizeof(vtkObject*));
+  }
+  return memorySize;
+}
+
+void vtkMRMLLayerDMObserverHub::SetCoalescing(bool isEnabled)
+{
+  m_eventObserver->SetCoalescing(isEnabled);
+}
+
+bool vtkMRMLLayerDMObserverHub::GetCoalescing() const
+{
+  return m_eventObserver->GetCoalescing();
+}
+
+void vtkMRMLLayerDMObserverHub::SetEventCoalesced(unsigned long event, bool isCoalesced)
+{
+  m_eventObserver->SetEventCoalesced(event, isCoalesced);
+}
+
+bool vtkMRMLLayerDMObserverHub::IsEventCoalesced(unsigned long event) const
+{
+  return m_eventObserver->IsEventCoalesced(event);
+}
+
+void vtkMRMLLayerDMObserverHub::Flush()
+{
+  m_eventObserver->Flush();
+}
+
+bool vtkMRMLLayerDMObserverHub::HasPendingEvents() const
+{
+  return m_eventObserver->GetNumberOfPendingEvents() > 0;
+}
+
+void vtkMRMLLayerDMObserverHub::Dispatch(vtkObject* caller, unsigned long eventId, void* callData)
+{
+  auto found = m_objects.find(caller);
+  if (found == m_objects.end())
+  {
+    return;
+  }
+
+  ObjectEntry* entry = found->second.get();
+  auto eventEntry = std::find_if(entry->Events.begin(), entry->Events.end(), [eventId](const EventEntry& e) { return e.Event == eventId; });
+  if (eventEntry != entry->Events.end())
+  {
+    // Subscribers and events can be added during the dispatch: access them by index.
+    // Subscribers added during the dispatch are only notified from the next event.
+    size_t iEvent = static_cast<size_t>(std::distance(entry->Events.begin(), eventEntry));
+    size_t nSubscribers = eventEntry->Subscribers.size();
+    ++m_dispatchDepth;
+    for (size_t iSubscriber = 0; iSubscriber < nSubscribers; ++iSubscriber)
+    {
+      if (auto pipeline = entry->Events[iEvent].Subscribers[iSubscriber])
+      {
+        pipeline->OnUpdate(caller, eventId, callData);
+      }
+    }
+    --m_dispatchDepth;
+  }
+
+  if (eventId == vtkCommand::DeleteEvent)
+  {
+    RemoveObject(caller);
+  }
+
+  if (m_dispatchDepth == 0)
+  {
+    Compact();
+  }
+}
+
+void vtkMRMLLayerDMObserverHub::RemoveSubscriber(vtkObject* obj, vtkMRMLLayerDMPipelineI* pipeline)
+{
+  auto found = m_objects.find(obj);
+  if (found == m_objects.end())
+  {
+    return;
+  }
+
+  // Keep the subscriber indices stable during dispatch, removed subscribers are compacted afterwards
+  for (auto& eventEntry : found->second->Events)
+  {
+    auto& subscribers = eventEntry.Subscribers;
+    std::replace(subscribers.begin(), subscribers.end(), pipeline, static_cast<vtkMRMLLayerDMPipelineI*>(nullptr));
+  }
+
+  if (m_dispatchDepth > 0)
+  {
+    m_modifiedObjects.emplace_back(obj);
+    return;
+  }
+  CompactObject(obj);
+}
+
+void vtkMRMLLayerDMObserverHub::RemoveObject(vtkObject* obj)
+{
+  auto found = m_objects.find(obj);
+  if (found == m_objects.end())
+  {
+    return;
+  }
+
+  auto& entry = found->second;
+  for (auto& eventEntry : entry->Events)
+  {
+    for (auto& subscriber : eventEntry.Subscribers)
+    {
+      if (!subscriber)
+      {
+        continue;
+      }
+
+      auto pipelineObjects = m_pipelineObjects.find(subscriber);
+      if (pipelineObjects != m_pipelineObjects.end())
+      {
+        auto& objects = pipelineObjects->second;
+        objects.erase(std::remove(objects.begin(), objects.end(), obj), objects.end());
+        if (objects.empty())
+        {
+          m_pipelineObjects.erase(pipelineObjects);
+        }
+      }
+      subscriber = nullptr;
+    }
+  }
+  m_eventObserver->RemoveObjectObservers(obj);
+
+  // The entry may be accessed by the current dispatch and is deleted once the dispatch is complete
+  if (m_dispatchDepth > 0)
+  {
+    m_removedObjects.emplace_back(std::move(entry));
+  }
+  m_objects.erase(found);
+}
+
+void vtkMRMLLayerDMObserverHub::RequestFlush(vtkObject* obj, unsigned long eventId)
+{
+  auto found = m_objects.find(obj);
+  if (found == m_objects.end())
+  {
+    return;
+  }
+
+  const auto& events = found->second->Events;
+  auto eventEntry = std::find_if(events.begin(), events.end(), [eventId](const EventEntry& e) { return e.Event == eventId; });
+  if (eventEntry == events.end())
+  {
+    return;
+  }
+
+  // Managers only schedule one render per flush
+  for (const auto& subscriber : eventEntry->Subscribers)
+  {
+    if (subscriber && subscriber->m_pipelineManager)
+    {
+      subscriber->m_pipelineManager->RequestObserverFlush();
+    }
+  }
+}
+
+void vtkMRMLLayerDMObserverHub::CompactObject(vtkObject* obj)
+{
+  auto found = m_objects.find(obj);
+  if (found == m_objects.end())
+  {
+    return;
+  }
+
+  auto& entry = found->second;
+  for (auto& eventEntry : entry->Events)
+  {
+    auto& subscribers = eventEntry.Subscribers;
+    subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), nullptr), subscribers.end());
+    if (subscribers.empty() && entry->Object && eventEntry.Event != vtkCommand::DeleteEvent)
+    {
+      m_eventObserver->RemoveEventObserver(obj, eventEntry.Event);
+    }
+  }
+
+  auto& events = entry->Events;
+  events.erase(std::remove_if(events.begin(), events.end(), [](const EventEntry& e) { return e.Subscribers.empty(); }), events.end());
+  if (events.empty())
+  {
+    RemoveObject(obj);
+  }
+}
+
+void vtkMRMLLayerDMObserverHub::Compact()
+{
+  auto modifiedObjects = std::move(m_modifiedObjects);
+  m_modifiedObjects.clear();
+  for (const auto& obj : modifiedObjects)
+  {
+    CompactObject(obj);
+  }
+  m_removedObjects.clear();
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class vtkMRMLLayerDMPipelineI;
+class vtkObjectEventObserver;
+
+/// \brief Observer hub shared by the pipelines of all the views.
+///
+/// Pipelines observing objects using \sa vtkMRMLLayerDMPipelineI::UpdateObserver subscribe to the hub instead of
+/// adding their own VTK observers. The hub adds a single VTK observer per observed (object, event) and fans out the
+/// events to the subscribed pipelines using \sa vtkMRMLLayerDMPipelineI::OnUpdate.
+///
+/// With N pipelines per view and V views observing the same view node, the view node carries one observer per event
+/// instead of N x V observers and each invoked event walks a compact subscriber list.
+///
+/// Subscriptions of deleted objects are removed on the object DeleteEvent. Pipelines are unsubscribed on deletion.
+/// Subscriptions can be modified while an event is dispatched: removed subscribers are not called anymore and added
+/// subscribers are called from the next event.
+///
+/// In coalescing mode, the events are delivered to the pipelines once per (object, event) on \sa Flush. The pipeline
+/// managers of the subscribed pipelines are notified of the pending events and flush the hub before rendering.
+/// As the hub is shared, the coalescing mode is a global switch applying to the pipelines of all the views.
+/// \sa vtkObjectEventObserver::SetCoalescing
+///
+/// The hub is not thread-safe and is expected to be used on the main thread.
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMObserverHub : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMObserverHub* New();
+  vtkTypeMacro(vtkMRMLLayerDMObserverHub, vtkObject);
+
+  /// \brief Singleton instance of the hub shared by the pipelines
+  static vtkSmartPointer<vtkMRMLLayerDMObserverHub> GetInstance();
+
+  /// Subscribe the pipeline to the object event.
+  /// \return false if the object or pipeline is nullptr or the pipeline is already subscribed.
+  bool Subscribe(vtkMRMLLayerDMPipelineI* pipeline, vtkObject* obj, unsigned long event);
+
+  /// Remove the subscriptions of the pipeline to all the events of the object.
+  void Unsubscribe(vtkMRMLLayerDMPipelineI* pipeline, vtkObject* obj);
+
+  /// Remove all the subscriptions of the pipeline.
+  void UnsubscribeAll(vtkMRMLLayerDMPipelineI* pipeline);
+
+  /// Number of objects observed by the hub.
+  int GetNumberOfObservedObjects() const;
+
+  /// Number of VTK observers added by the hub, including the DeleteEvent observers.
+  int GetNumberOfObservers() const;
+
+  /// Number of (pipeline, object, event) subscriptions.
+  int GetNumberOfSubscriptions() const;
+
+  /// Estimated memory used by the subscription table in bytes.
+  unsigned long GetMemorySize() const;
+
+  /// @{
+  /// Coalesce the events delivered to the pipelines until the next \sa Flush. Disabled by default.
+  /// Global switch: applies to the pipelines of all the pipeline managers sharing the hub instance.
+  /// Disabling the coalescing flushes the pending events.
+  void SetCoalescing(bool isEnabled);
+  bool GetCoalescing() const;
+  /// @}
+
+  /// @{
+  /// Per-event opt-out of the coalescing for events whose call data must be delivered immediately.
+  /// DeleteEvent is always delivered immediately.
+  void SetEventCoalesced(unsigned long event, bool isCoalesced);
+  bool IsEventCoalesced(unsigned long event) const;
+  /// @}
+
+  /// Deliver the pending coalesced events to the subscribed pipelines with a nullptr call data.
+  void Flush();
+
+  /// true if coalesced events are waiting for the next \sa Flush.
+  bool HasPendingEvents() const;
+
+protected:
+  vtkMRMLLayerDMObserverHub();
+  ~vtkMRMLLayerDMObserverHub() override;
+
+private:
+  struct EventEntry
+  {
+    unsigned long Event{ 0 };
+    // Removed subscribers are set to nullptr while dispatching and compacted afterwards
+    std::vector<vtkMRMLLayerDMPipelineI*> Subscribers;
+  };
+
+  struct ObjectEntry
+  {
+    vtkWeakPointer<vtkObject> Object;
+    std::vector<EventEntry> Events;
+  };
+
+  void Dispatch(vtkObject* caller, unsigned long eventId, void* callData);
+  void RemoveSubscriber(vtkObject* obj, vtkMRMLLayerDMPipelineI* pipeline);
+  void RemoveObject(vtkObject* obj);
+
+  /// Request a flush from the pipeline managers of the pipelines subscribed to the pending event.
+  void RequestFlush(vtkObject* obj, unsigned long eventId);
+
+  /// Remove the subscribers and events removed from the object during dispatch.
+  /// Removes the object if it doesn't have any subscriber anymore.
+  void CompactObject(vtkObject* obj);
+
+  /// Compact the objects modified during dispatch and delete the entries removed during dispatch.
+  void Compact();
+
+  // Single VTK observer per observed (object, event), including the object DeleteEvent
+  vtkSmartPointer<vtkObjectEventObserver> m_eventObserver;
+
+  // Entries are heap allocated to stay valid while dispatching if the table is modified
+  std::unordered_map<vtkObject*, std::unique_ptr<ObjectEntry>> m_objects;
+
+  // Objects observed by each pipeline for fast unsubscription
+  std::unordered_map<vtkMRMLLayerDMPipelineI*, std::vector<vtkObject*>> m_pipelineObjects;
+
+  // Entries removed during dispatch, deleted when the dispatch is complete
+  std::vector<std::unique_ptr<ObjectEntry>> m_removedObjects;
+  std::vector<vtkObject*> m_modifiedObjects;
+  int m_dispatchDepth;
+};
@@ -8,4 +8,16 @@ vtkStandardNewMacro(vtkMRMLLayerDMPipelineCreatorI);
 vtkSmartPointer<vtkMRMLLayerDMPipelineI> vtkMRMLLayerDMPipelineCreatorI::CreatePipeline(vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node) const
 {
   return {};
+}
+
+std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> vtkMRMLLayerDMPipelineCreatorI::CreatePipelines(vtkMRMLAbstractViewNode* viewNode,
+                                                                                                      const std::vector<vtkMRMLNode*>& nodes) const
+{
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> pipelines;
+  pipelines.reserve(nodes.size());
+  for (auto node : nodes)
+  {
+    pipelines.emplace_back(CreatePipeline(viewNode, node));
+  }
+  return pipelines;
 }
\ No newline at end of file
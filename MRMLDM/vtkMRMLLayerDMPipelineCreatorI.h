@@ -5,6 +5,8 @@
 #include "vtkMRMLLayerDMPipelineI.h"
 #include <vtkObject.h>
 
+#include <vector>
+
 class vtkMRMLAbstractViewNode;
 class vtkMRMLNode;
 
@@ -20,6 +22,13 @@ public:
 
   virtual vtkSmartPointer<vtkMRMLLayerDMPipelineI> CreatePipeline(vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node) const;
 
+  /// Create the pipelines for all the input nodes in a single call.
+  /// Used by \sa vtkMRMLLayerDMPipelineFactory::CreatePipelines during full scene synchronization.
+  /// \return One pipeline per input node, nullptr for the nodes not handled by the creator.
+  /// default behavior: calls \sa CreatePipeline for each node.
+  virtual std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> CreatePipelines(vtkMRMLAbstractViewNode* viewNode,
+                                                                                const std::vector<vtkMRMLNode*>& nodes) const;
+
 protected:
   vtkMRMLLayerDMPipelineCreatorI() = default;
   ~vtkMRMLLayerDMPipelineCreatorI() override = default;
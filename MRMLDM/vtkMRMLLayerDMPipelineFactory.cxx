@@ -6,6 +6,8 @@
 #include <vtkCommand.h>
 #include <vtkObjectFactory.h>
 
+#include <numeric>
+
 vtkStandardNewMacro(vtkMRMLLayerDMPipelineFactory);
 
 vtkSmartPointer<vtkMRMLLayerDMPipelineFactory> vtkMRMLLayerDMPipelineFactory::GetInstance()
@@ -68,6 +70,52 @@ vtkSmartPointer<vtkMRMLLayerDMPipelineI> vtkMRMLLayerDMPipelineFactory::CreatePi
   return {};
 }
 
+std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> vtkMRMLLayerDMPipelineFactory::CreatePipelines(vtkMRMLAbstractViewNode* viewNode,
+                                                                                                      const std::vector<vtkMRMLNode*>& nodes)
+{
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> pipelines(nodes.size());
+
+  // Indices of the nodes not yet handled by a creator
+  std::vector<size_t> remaining(nodes.size());
+  std::iota(remaining.begin(), remaining.end(), 0);
+
+  std::vector<vtkMRMLNode*> remainingNodes;
+  for (const auto& ctor : m_pipelineCreators)
+  {
+    if (remaining.empty())
+    {
+      break;
+    }
+
+    remainingNodes.clear();
+    for (size_t iNode : remaining)
+    {
+      remainingNodes.emplace_back(nodes[iNode]);
+    }
+
+    auto created = ctor->CreatePipelines(viewNode, remainingNodes);
+    std::vector<size_t> notCreated;
+    for (size_t iRemaining = 0; iRemaining < remaining.size(); ++iRemaining)
+    {
+      size_t iNode = remaining[iRemaining];
+      if (iRemaining >= created.size() || !created[iRemaining])
+      {
+        notCreated.emplace_back(iNode);
+        continue;
+      }
+
+      pipelines[iNode] = created[iRemaining];
+      m_lastView = viewNode;
+      m_lastNode = nodes[iNode];
+      m_lastPipeline = pipelines[iNode];
+      InvokeEvent(PipelineAboutToBeCreatedEvent);
+    }
+    remaining = std::move(notCreated);
+  }
+
+  return pipelines;
+}
+
 vtkMRMLAbstractViewNode* vtkMRMLLayerDMPipelineFactory::GetLastViewNode() const
 {
   return m_lastView;
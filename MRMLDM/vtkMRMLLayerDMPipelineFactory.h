@@ -59,6 +59,13 @@ public:
   /// \sa GetLastPipeline
   vtkSmartPointer<vtkMRMLLayerDMPipelineI> CreatePipeline(vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node);
 
+  /// Batch version of \sa CreatePipeline used during full scene synchronization.
+  /// Each creator is called once with the nodes not handled by the previous creators using
+  /// \sa vtkMRMLLayerDMPipelineCreatorI::CreatePipelines.
+  /// Invokes PipelineAboutToBeCreatedEvent for each created pipeline.
+  /// \return One pipeline per input node, nullptr for the nodes no creator was able to handle.
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> CreatePipelines(vtkMRMLAbstractViewNode* viewNode, const std::vector<vtkMRMLNode*>& nodes);
+
   /// @{
   /// Get the last pipeline created by the factory.
   /// Values are valid when the PipelineAboutToBeCreatedEvent event is triggered.
@@ -1,5 +1,6 @@
 #include "vtkMRMLLayerDMPipelineI.h"
 
+#include "vtkMRMLLayerDMObserverHub.h"
 #include "vtkMRMLLayerDMPipelineManager.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLAbstractWidget.h"
@@ -7,6 +8,8 @@
 #include <vtkObjectFactory.h>
 #include <vtkRenderer.h>
 
+#include <limits>
+
 vtkStandardNewMacro(vtkMRMLLayerDMPipelineI);
 
 void vtkMRMLLayerDMPipelineI::UpdatePipeline() {}
@@ -29,6 +32,10 @@ void vtkMRMLLayerDMPipelineI::ResetDisplay()
   }
 
   UpdatePipeline();
+  if (IsUpdateAsync())
+  {
+    RequestAsyncUpdate();
+  }
 }
 
 void vtkMRMLLayerDMPipelineI::SetViewNode(vtkMRMLAbstractViewNode* viewNode)
@@ -47,6 +54,12 @@ void vtkMRMLLayerDMPipelineI::SetRenderer(vtkRenderer* renderer)
   OnRendererRemoved(m_renderer);
   m_renderer = renderer;
   OnRendererAdded(m_renderer);
+
+  // The scheduled update already includes the new renderer
+  if (m_isUpdateScheduled)
+  {
+    return;
+  }
   UpdatePipeline();
 }
 
@@ -62,6 +75,33 @@ bool vtkMRMLLayerDMPipelineI::CanProcessInteractionEvent(vtkMRMLInteractionEvent
   return false;
 }
 
+bool vtkMRMLLayerDMPipelineI::IsCanProcessInteractionEventThreadSafe() const
+{
+  return false;
+}
+
+const void* vtkMRMLLayerDMPipelineI::GetCanProcessBatchKey() const
+{
+  return nullptr;
+}
+
+void vtkMRMLLayerDMPipelineI::CanProcessInteractionEventBatch(const std::vector<vtkMRMLLayerDMPipelineI*>& pipelines,
+                                                              vtkMRMLInteractionEventData* eventData,
+                                                              std::vector<CanProcessResult>& results)
+{
+  results.assign(pipelines.size(), std::make_tuple(false, std::numeric_limits<double>::max(), 0, 0u));
+  for (size_t iPipeline = 0; iPipeline < pipelines.size(); ++iPipeline)
+  {
+    auto& [canProcess, distance2, widgetState, renderLayer] = results[iPipeline];
+    canProcess = pipelines[iPipeline]->CanProcessInteractionEvent(eventData, distance2);
+    if (canProcess)
+    {
+      widgetState = pipelines[iPipeline]->GetWidgetState();
+      renderLayer = pipelines[iPipeline]->GetRenderLayer();
+    }
+  }
+}
+
 bool vtkMRMLLayerDMPipelineI::ProcessInteractionEvent(vtkMRMLInteractionEventData* eventData)
 {
   return false;
@@ -81,14 +121,67 @@ void vtkMRMLLayerDMPipelineI::LoseFocus(vtkMRMLInteractionEventData* eventData)
 
 void vtkMRMLLayerDMPipelineI::OnDefaultCameraModified(vtkCamera* camera) {}
 
+void vtkMRMLLayerDMPipelineI::OnDefaultCameraChanged(vtkCamera* camera, int cameraChanges)
+{
+  OnDefaultCameraModified(camera);
+}
+
+void vtkMRMLLayerDMPipelineI::SetDefaultCameraChangeMask(int cameraChangeMask)
+{
+  m_defaultCameraChangeMask = cameraChangeMask;
+}
+
+int vtkMRMLLayerDMPipelineI::GetDefaultCameraChangeMask() const
+{
+  return m_defaultCameraChangeMask;
+}
+
+void vtkMRMLLayerDMPipelineI::OnBeforeRender(vtkMRMLLayerDMRenderContext* context) {}
+
+void vtkMRMLLayerDMPipelineI::SetViewDependencyMask(int cameraChangeMask)
+{
+  m_viewDependencyMask = cameraChangeMask;
+}
+
+int vtkMRMLLayerDMPipelineI::GetViewDependencyMask() const
+{
+  return m_viewDependencyMask;
+}
+
+void vtkMRMLLayerDMPipelineI::RequestBeforeRender()
+{
+  m_isBeforeRenderRequested = true;
+  RequestRender();
+}
+
+void vtkMRMLLayerDMPipelineI::RequestUpdate()
+{
+  if (m_pipelineManager)
+  {
+    m_pipelineManager->ScheduleUpdate(this);
+  }
+}
+
 bool vtkMRMLLayerDMPipelineI::UpdateObserver(vtkObject* prevObj, vtkObject* obj, unsigned long event) const
 {
-  return m_obs->UpdateObserver(prevObj, obj, event);
+  return UpdateObserver(prevObj, obj, std::vector<unsigned long>{ event });
 }
 
 bool vtkMRMLLayerDMPipelineI::UpdateObserver(vtkObject* prevObj, vtkObject* obj, const std::vector<unsigned long>& events) const
 {
-  return m_obs->UpdateObserver(prevObj, obj, events);
+  if (prevObj == obj)
+  {
+    return false;
+  }
+
+  // Subscriptions don't modify the observable state of the pipeline
+  auto pipeline = const_cast<vtkMRMLLayerDMPipelineI*>(this);
+  m_observerHub->Unsubscribe(pipeline, prevObj);
+  for (const auto& event : events)
+  {
+    m_observerHub->Subscribe(pipeline, obj, event);
+  }
+  return true;
 }
 
 unsigned int vtkMRMLLayerDMPipelineI::GetRenderLayer() const
@@ -115,6 +208,24 @@ vtkMRMLLayerDMPipelineI* vtkMRMLLayerDMPipelineI::GetNodePipeline(vtkMRMLNode* n
   return m_pipelineManager->GetNodePipeline(node);
 }
 
+vtkMRMLLayerDMCellLocatorCache* vtkMRMLLayerDMPipelineI::GetCellLocatorCache() const
+{
+  if (!m_pipelineManager)
+  {
+    return nullptr;
+  }
+  return m_pipelineManager->GetCellLocatorCache();
+}
+
+vtkMRMLLayerDMInteractionContext* vtkMRMLLayerDMPipelineI::GetInteractionContext() const
+{
+  if (!m_pipelineManager)
+  {
+    return nullptr;
+  }
+  return m_pipelineManager->GetInteractionContext(m_renderer);
+}
+
 vtkMRMLAbstractViewNode* vtkMRMLLayerDMPipelineI::GetViewNode() const
 {
   return m_viewNode;
@@ -137,6 +248,46 @@ vtkMRMLScene* vtkMRMLLayerDMPipelineI::GetScene() const
 
 void vtkMRMLLayerDMPipelineI::OnUpdate(vtkObject* obj, unsigned long eventId, void* callData) {}
 
+bool vtkMRMLLayerDMPipelineI::IsUpdateAsync() const
+{
+  return false;
+}
+
+void vtkMRMLLayerDMPipelineI::ComputeUpdateAsync() {}
+
+void vtkMRMLLayerDMPipelineI::ApplyUpdate() {}
+
+void vtkMRMLLayerDMPipelineI::WaitForAsyncUpdate(const std::future<void>& future) const
+{
+  future.wait();
+}
+
+void vtkMRMLLayerDMPipelineI::RequestAsyncUpdate()
+{
+  if (m_pipelineManager)
+  {
+    m_pipelineManager->ScheduleAsyncUpdate(this);
+  }
+}
+
+bool vtkMRMLLayerDMPipelineI::IsAsyncUpdateCancelled() const
+{
+  return m_isAsyncUpdateCancelled;
+}
+
+void vtkMRMLLayerDMPipelineI::SetAsyncUpdateCancelled(bool isCancelled)
+{
+  m_isAsyncUpdateCancelled = isCancelled;
+}
+
+void vtkMRMLLayerDMPipelineI::RequestLayerUpdate()
+{
+  if (m_pipelineManager)
+  {
+    m_pipelineManager->UpdatePipelineLayer(this);
+  }
+}
+
 void vtkMRMLLayerDMPipelineI::RequestRender() const
 {
   if (m_pipelineManager)
@@ -155,8 +306,17 @@ vtkMRMLLayerDMPipelineI::vtkMRMLLayerDMPipelineI()
   , m_displayNode{ nullptr }
   , m_renderer{ nullptr }
   , m_isResetDisplayBlocked{ false }
-  , m_obs(vtkSmartPointer<vtkObjectEventObserver>::New())
+  , m_defaultCameraChangeMask{ CameraAllChanges }
+  , m_viewDependencyMask{ CameraNoChange }
+  , m_isBeforeRenderRequested{ false }
+  , m_isUpdateScheduled{ false }
+  , m_isAsyncUpdateCancelled{ false }
+  , m_observerHub(vtkMRMLLayerDMObserverHub::GetInstance())
   , m_pipelineManager(nullptr)
 {
-  m_obs->SetUpdateCallback([this](vtkObject* obj, unsigned long eventId, void* callData) { OnUpdate(obj, eventId, callData); });
 };
+
+vtkMRMLLayerDMPipelineI::~vtkMRMLLayerDMPipelineI()
+{
+  m_observerHub->UnsubscribeAll(this);
+}
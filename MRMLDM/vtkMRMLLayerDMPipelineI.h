@@ -5,18 +5,27 @@
 #include "vtkMRMLAbstractViewNode.h"
 #include "vtkObjectEventObserver.h"
 
+#include <vtkCommand.h>
 #include <vtkObject.h>
+#include <vtkWrappingHints.h>
+#include <atomic>
 #include <functional>
+#include <future>
+#include <tuple>
+#include <vector>
 #include <vtkMRMLLayerDMPipelineManager.h>
 
 class vtkCamera;
 class vtkMRMLAbstractViewNode;
 class vtkMRMLInteractionEventData;
+class vtkMRMLLayerDMCellLocatorCache;
+class vtkMRMLLayerDMInteractionContext;
+class vtkMRMLLayerDMObserverHub;
 class vtkMRMLLayerDMPipelineI;
 class vtkMRMLLayerDMPipelineManager;
+class vtkMRMLLayerDMRenderContext;
 class vtkMRMLNode;
 class vtkMRMLScene;
-class vtkObjectEventObserver;
 class vtkRenderer;
 
 /// \brief Interface for the layered displayable manager pipelines.
@@ -35,12 +44,56 @@ public:
   static vtkMRMLLayerDMPipelineI* New();
   vtkTypeMacro(vtkMRMLLayerDMPipelineI, vtkObject);
 
+  /// Default camera components changed since the previous \sa OnDefaultCameraChanged notification.
+  enum CameraChange
+  {
+    CameraNoChange = 0,
+    /// Projection type, view angle, parallel scale, window center or distance of perspective cameras (zoom)
+    CameraProjectionChange = 1 << 0,
+    /// Direction of projection or view up (rotation)
+    CameraOrientationChange = 1 << 1,
+    /// Position or focal point (pan, rotation or dolly)
+    CameraPositionChange = 1 << 2,
+    /// Near and far clipping planes
+    CameraClippingRangeChange = 1 << 3,
+    CameraAllChanges = CameraProjectionChange | CameraOrientationChange | CameraPositionChange | CameraClippingRangeChange
+  };
+
   /// true if the pipeline can process the input event data
   /// \param eventData: The MRML event needing to be processed
   /// \param distance2: Return value for the distance to the interaction (preferably actual RAS distance)
   /// \return true if the pipeline can process the input event data. Default = false;
   virtual bool CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2);
 
+  /// true if \sa CanProcessInteractionEvent is read-only and can be called concurrently with the other pipelines.
+  /// Thread-safe pipelines are evaluated in parallel by \sa vtkMRMLLayerDMInteractionLogic.
+  /// Implementations returning true must only use the const accessors of the event data and must not modify the
+  /// pipeline, its nodes or the scene during \sa CanProcessInteractionEvent.
+  /// \return false by default.
+  virtual bool IsCanProcessInteractionEventThreadSafe() const;
+
+  /// Key grouping the pipelines evaluated together by \sa CanProcessInteractionEventBatch.
+  /// Pipelines sharing a costly setup for \sa CanProcessInteractionEvent (for instance the python GIL acquisition)
+  /// can return the same non-null key to be evaluated with a single batch call per interaction event.
+  /// \return nullptr by default (pipeline evaluated individually).
+  virtual const void* GetCanProcessBatchKey() const;
+
+  /// Can process, distance2, widget state and render layer of a pipeline evaluated by
+  /// \sa CanProcessInteractionEventBatch. The widget state and render layer are used to prioritize the pipelines and
+  /// are only evaluated for the pipelines which can process the event.
+  using CanProcessResult = std::tuple<bool, double, int, unsigned int>;
+
+  /// Evaluate \sa CanProcessInteractionEvent for all the input pipelines sharing this pipeline's batch key.
+  /// For the pipelines which can process the event, \sa GetWidgetState and \sa GetRenderLayer are evaluated in the
+  /// same call.
+  /// Called once per event on the first pipeline of each batch by \sa vtkMRMLLayerDMInteractionLogic.
+  /// \param results: Output result for each input pipeline, resized to the number of pipelines.
+  /// default behavior: calls \sa CanProcessInteractionEvent, \sa GetWidgetState and \sa GetRenderLayer for each
+  /// pipeline.
+  virtual void CanProcessInteractionEventBatch(const std::vector<vtkMRMLLayerDMPipelineI*>& pipelines,
+                                               vtkMRMLInteractionEventData* eventData,
+                                               std::vector<CanProcessResult>& results);
+
   /// Custom pipeline camera.
   /// If the returned value is not nullptr, then the pipeline (or dedicated logic) is expected to handle its own camera.
   /// Otherwise, the pipeline will be moved in a renderer with a default camera synchronized on its view default camera.
@@ -71,6 +124,18 @@ public:
   /// default behavior: does nothing.
   virtual void OnDefaultCameraModified(vtkCamera* camera);
 
+  /// Triggered when the default camera is modified.
+  /// Only called if the modified camera components match the pipeline's \sa GetDefaultCameraChangeMask.
+  /// \param cameraChanges: bit mask of the \sa CameraChange components modified since the previous notification.
+  /// default behavior: calls \sa OnDefaultCameraModified.
+  virtual void OnDefaultCameraChanged(vtkCamera* camera, int cameraChanges);
+
+  /// Triggered once per frame before the view is rendered if the view-dependent inputs of the pipeline changed since
+  /// the previous frame (\sa SetViewDependencyMask) or if requested using \sa RequestBeforeRender.
+  /// Render requests made during the call are included in the starting render.
+  /// default behavior: does nothing.
+  virtual void OnBeforeRender(vtkMRMLLayerDMRenderContext* context);
+
   /// Triggered when the pipeline is displayed on a new renderer.
   /// default behavior: does nothing.
   virtual void OnRendererAdded(vtkRenderer* renderer);
@@ -105,9 +170,54 @@ public:
   /// default behavior: does nothing.
   virtual void UpdatePipeline();
 
+  /// true if the pipeline implements \sa ComputeUpdateAsync and \sa ApplyUpdate.
+  /// Asynchronous updates are scheduled after \sa UpdatePipeline in \sa ResetDisplay.
+  /// \return false by default.
+  virtual bool IsUpdateAsync() const;
+
+  /// Compute the expensive part of the pipeline update on a worker thread.
+  /// Must not modify the rendered VTK objects, nodes or scene. Results are expected to be stored by the pipeline
+  /// and used in \sa ApplyUpdate. Long computations should stop early when \sa IsAsyncUpdateCancelled is true.
+  /// Exceptions are reported by the pipeline manager as failed updates and \sa ApplyUpdate is not called.
+  /// default behavior: does nothing.
+  virtual void ComputeUpdateAsync();
+
+  /// Apply the result of the last completed and not cancelled \sa ComputeUpdateAsync on the main thread.
+  /// A render is requested by the pipeline manager after the update is applied.
+  /// default behavior: does nothing.
+  virtual void ApplyUpdate();
+
+  /// Block until the running \sa ComputeUpdateAsync notifies the input future.
+  /// Called on the main thread by the pipeline manager when waiting for the asynchronous updates and on destruction.
+  /// Pipelines whose \sa ComputeUpdateAsync needs a lock held by the waiting thread (for instance the python GIL)
+  /// should release it while waiting.
+  /// default behavior: waits for the future.
+  virtual void WaitForAsyncUpdate(const std::future<void>& future) const;
+
   /// If \param isBlocked is true, \sa UpdatePipeline is not called during \sa ResetDisplay.
   bool BlockResetDisplay(bool isBlocked);
 
+  /// Returns the cell locator cache shared by all the pipelines.
+  /// Delegates to \sa vtkMRMLLayerDMPipelineManager::GetCellLocatorCache.
+  /// nullptr if pipelineManager instance is nullptr.
+  vtkMRMLLayerDMCellLocatorCache* GetCellLocatorCache() const;
+
+  /// @{
+  /// Bit mask of the \sa CameraChange components triggering \sa OnDefaultCameraChanged.
+  /// Pipelines only depending on some of the camera components (for instance screen-space sized glyphs reacting to
+  /// the zoom) can restrict the mask to skip the other camera modifications. Default = CameraAllChanges.
+  void SetDefaultCameraChangeMask(int cameraChangeMask);
+  int GetDefaultCameraChangeMask() const;
+  /// @}
+
+  /// @{
+  /// Bit mask of the \sa CameraChange components the view-dependent geometry of the pipeline depends on.
+  /// \sa OnBeforeRender is called on the frames where one of these components or the view size changed, and on the
+  /// first frame after the pipeline is added. Default = CameraNoChange (pipeline is not view dependent).
+  void SetViewDependencyMask(int cameraChangeMask);
+  int GetViewDependencyMask() const;
+  /// @}
+
   /// Returns the current display node.
   vtkMRMLNode* GetDisplayNode() const;
 
@@ -116,6 +226,12 @@ public:
   /// nullptr if not found or pipelineManager instance is nullptr.
   vtkMRMLLayerDMPipelineI* GetNodePipeline(vtkMRMLNode* node) const;
 
+  /// Returns the interaction context of the pipeline's renderer for the event being processed.
+  /// Valid during \sa CanProcessInteractionEvent and \sa ProcessInteractionEvent calls.
+  /// Delegates to \sa vtkMRMLLayerDMPipelineManager::GetInteractionContext.
+  /// nullptr if not found or pipelineManager instance is nullptr.
+  vtkMRMLLayerDMInteractionContext* GetInteractionContext() const;
+
   /// Returns the current renderer attached to the pipeline.
   /// \sa OnRendererAdded
   /// \sa OnRendererRemoved
@@ -131,6 +247,7 @@ public:
   /// Remove previous monitored events from \param prevObj and observe events from the \param obj.
   /// If both obj are the same, does nothing.
   /// On event triggerred, calls \sa OnUpdate
+  /// Observers are shared between the pipelines using \sa vtkMRMLLayerDMObserverHub.
   bool UpdateObserver(vtkObject* prevObj, vtkObject* obj, const std::vector<unsigned long>& events) const;
   bool UpdateObserver(vtkObject* prevObj, vtkObject* obj, unsigned long event = vtkCommand::ModifiedEvent) const;
   /// @}
@@ -140,28 +257,62 @@ public:
   /// Called the first time after pipeline initialization.
   void ResetDisplay();
 
+  /// Request the pipeline to be moved to the renderer matching its current \sa GetRenderLayer and \sa GetCamera.
+  /// Should be called when the render layer or camera of the pipeline changes after its initialization.
+  /// Calls are delegated to \sa vtkMRMLLayerDMPipelineManager::UpdatePipelineLayer.
+  void RequestLayerUpdate();
+
+  /// Schedule an asynchronous update of the pipeline.
+  /// Supersedes and cancels the asynchronous update currently running if any.
+  /// Calls are delegated to \sa vtkMRMLLayerDMPipelineManager::ScheduleAsyncUpdate.
+  void RequestAsyncUpdate();
+
+  /// @{
+  /// true if the running \sa ComputeUpdateAsync has been superseded by a new request and its result will be discarded.
+  /// Set by \sa vtkMRMLLayerDMPipelineManager. Thread-safe.
+  bool IsAsyncUpdateCancelled() const;
+  void SetAsyncUpdateCancelled(bool isCancelled);
+  /// @}
+
+  /// Request an \sa OnBeforeRender call on the next frame and request a render.
+  void RequestBeforeRender();
+
+  /// Request a \sa ResetDisplay of the pipeline within the update budget of the next frames.
+  /// Calls are delegated to \sa vtkMRMLLayerDMPipelineManager::ScheduleUpdate.
+  void RequestUpdate();
+
   /// Request rendering and camera clipping reset.
   /// Calls are delegated to \sa vtkMRMLLayerDMPipelineManager::RequestRender.
-  void RequestRender() const;
+  /// The python GIL is released during the call.
+  VTK_UNBLOCKTHREADS void RequestRender() const;
 
   /// Set the new renderer.
   /// Triggers \sa OnRendererAdded and \sa OnRendererRemoved if renderer has changed.
+  /// Calls \sa UpdatePipeline unless an update of the pipeline is already scheduled by the pipeline manager.
   void SetRenderer(vtkRenderer* renderer);
 
 protected:
   vtkMRMLLayerDMPipelineI();
-  ~vtkMRMLLayerDMPipelineI() override = default;
+  ~vtkMRMLLayerDMPipelineI() override;
 
   /// Observer update callback.
   /// Triggered when any object & events observed using UpdateObserver is triggered.
   virtual void OnUpdate(vtkObject* obj, unsigned long eventId, void* callData);
 
 private:
+  friend class vtkMRMLLayerDMObserverHub;
+  friend class vtkMRMLLayerDMPipelineManager;
+
   vtkWeakPointer<vtkMRMLAbstractViewNode> m_viewNode;
   vtkWeakPointer<vtkMRMLNode> m_displayNode;
   vtkWeakPointer<vtkRenderer> m_renderer;
   bool m_isResetDisplayBlocked;
-  vtkSmartPointer<vtkObjectEventObserver> m_obs;
+  int m_defaultCameraChangeMask;
+  int m_viewDependencyMask;
+  bool m_isBeforeRenderRequested;
+  bool m_isUpdateScheduled;
+  std::atomic<bool> m_isAsyncUpdateCancelled;
+  vtkSmartPointer<vtkMRMLLayerDMObserverHub> m_observerHub;
   vtkWeakPointer<vtkMRMLLayerDMPipelineManager> m_pipelineManager;
   vtkWeakPointer<vtkMRMLScene> m_scene;
 };
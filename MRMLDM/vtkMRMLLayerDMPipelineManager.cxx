@@ -1,20 +1,65 @@
 #include "vtkMRMLLayerDMPipelineManager.h"
 
+#include "vtkMRMLLayerDMCellLocatorCache.h"
 #include "vtkMRMLLayerDMLayerManager.h"
 #include "vtkMRMLLayerDMPipelineFactory.h"
 #include "vtkObjectEventObserver.h"
 #include "vtkMRMLLayerDMPipelineI.h"
 #include "vtkMRMLLayerDMCameraSynchronizer.h"
+#include "vtkMRMLLayerDMCameraGroupRegistry.h"
 #include "vtkMRMLLayerDMInteractionLogic.h"
+#include "vtkMRMLLayerDMInteractionRecorder.h"
+#include "vtkMRMLLayerDMObserverHub.h"
+#include "vtkMRMLLayerDMRenderContext.h"
 
 #include <vtkCallbackCommand.h>
 #include <vtkMRMLAbstractViewNode.h>
+#include <vtkMRMLDisplayNode.h>
 #include <vtkMRMLInteractionEventData.h>
 #include <vtkMRMLScene.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
 #include <vtkCamera.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Period of the interactor timer polling the completed asynchronous updates
+constexpr unsigned long ASYNC_UPDATE_POLLING_PERIOD_MS = 16;
+
+// Priorities of the scheduled pipeline updates, lower values are updated first
+enum UpdatePriority
+{
+  FocusedUpdatePriority,
+  VisibleUpdatePriority,
+  HiddenUpdatePriority
+};
+
+// Tolerance of the camera values derived from the position and focal point (direction and distance)
+constexpr double CAMERA_DERIVED_VALUE_TOLERANCE = 1e-9;
+
+template <size_t N>
+bool IsChanged(const std::array<double, N>& prev, const std::array<double, N>& current, double tolerance = 0.)
+{
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (std::abs(prev[i] - current[i]) > tolerance)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 vtkStandardNewMacro(vtkMRMLLayerDMPipelineManager);
 
 bool vtkMRMLLayerDMPipelineManager::CreatePipelineForNode(vtkMRMLNode* displayNode)
@@ -31,20 +76,51 @@ bool vtkMRMLLayerDMPipelineManager::CreatePipelineForNode(vtkMRMLNode* displayNo
     return false;
   }
 
+  AddPipeline(displayNode, pipeline);
+  InvokeEvent(vtkCommand::ModifiedEvent);
+  InvokeUpdatesSettledEventIfNeeded();
+  return true;
+}
+
+void vtkMRMLLayerDMPipelineManager::AddPipeline(vtkMRMLNode* displayNode, const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline)
+{
   pipeline->SetPipelineManager(this);
   pipeline->SetScene(m_scene);
   pipeline->SetViewNode(m_viewNode);
   pipeline->SetDisplayNode(displayNode);
   m_pipelineMap[displayNode] = pipeline;
+
+  // With an update budget, the renderer assignment is part of the scheduled update of the new pipeline
+  const bool isUpdateScheduled = m_updateBudget > 0;
+  if (isUpdateScheduled)
+  {
+    SchedulePipelineUpdate(pipeline);
+  }
   m_layerManager->AddPipeline(pipeline);
+  if (m_cameraSyncMode == vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera)
+  {
+    WarnIfSharedCameraConflict(pipeline);
+  }
+
+  // View-dependent geometry is initialized on the first frame
+  if (pipeline->GetViewDependencyMask() != vtkMRMLLayerDMPipelineI::CameraNoChange)
+  {
+    pipeline->m_isBeforeRenderRequested = true;
+  }
   m_interactionLogic->AddPipeline(pipeline);
-  UpdatePipeline(pipeline);
-  InvokeEvent(vtkCommand::ModifiedEvent);
-  return true;
+  if (!isUpdateScheduled)
+  {
+    SchedulePipelineUpdate(pipeline);
+  }
 }
 
 void vtkMRMLLayerDMPipelineManager::ClearDisplayableNodes()
 {
+  for (const auto& pipeline : m_scheduledUpdates)
+  {
+    pipeline->m_isUpdateScheduled = false;
+  }
+  m_scheduledUpdates.clear();
   m_pipelineMap.clear();
 }
 
@@ -58,12 +134,19 @@ bool vtkMRMLLayerDMPipelineManager::AddNode(vtkMRMLNode* node)
   return CreatePipelineForNode(node);
 }
 
-void vtkMRMLLayerDMPipelineManager::UpdateAllPipelines() const
+void vtkMRMLLayerDMPipelineManager::UpdateAllPipelines()
 {
   for (const auto& pipeline : m_pipelineMap)
   {
-    UpdatePipeline(pipeline.second);
+    SchedulePipelineUpdate(pipeline.second);
   }
+  InvokeUpdatesSettledEventIfNeeded();
+}
+
+void vtkMRMLLayerDMPipelineManager::UpdatePipelineLayer(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  m_layerManager->UpdatePipelineLayer(pipeline);
+  RequestRender();
 }
 
 bool vtkMRMLLayerDMPipelineManager::RemovePipeline(vtkMRMLNode* displayNode)
@@ -77,13 +160,39 @@ bool vtkMRMLLayerDMPipelineManager::RemovePipeline(vtkMRMLNode* displayNode)
   m_layerManager->RemovePipeline(pipeline);
   m_interactionLogic->RemovePipeline(pipeline);
   m_pipelineMap.erase(displayNode);
+
+  // Running asynchronous update is discarded on completion
+  auto asyncUpdate = m_asyncUpdates.find(pipeline);
+  if (asyncUpdate != m_asyncUpdates.end())
+  {
+    pipeline->SetAsyncUpdateCancelled(true);
+    asyncUpdate->second.IsRerunNeeded = false;
+  }
+
+  // Pipelines being updated by the scheduler are skipped using their flag
+  if (pipeline->m_isUpdateScheduled)
+  {
+    pipeline->m_isUpdateScheduled = false;
+    m_scheduledUpdates.erase(std::remove(m_scheduledUpdates.begin(), m_scheduledUpdates.end(), pipeline), m_scheduledUpdates.end());
+  }
   InvokeEvent(vtkCommand::ModifiedEvent);
+  InvokeUpdatesSettledEventIfNeeded();
   return true;
 }
 
-void vtkMRMLLayerDMPipelineManager::SetRenderWindow(vtkRenderWindow* renderWindow) const
+void vtkMRMLLayerDMPipelineManager::SetRenderWindow(vtkRenderWindow* renderWindow)
 {
+  if (m_asyncTimerInteractor)
+  {
+    m_asyncTimerInteractor->DestroyTimer(m_asyncTimerId);
+    m_eventObs->UpdateObserver(m_asyncTimerInteractor, nullptr, vtkCommand::TimerEvent);
+    m_asyncTimerInteractor = nullptr;
+  }
+
+  m_eventObs->UpdateObserver(m_renderWindow, renderWindow, { vtkCommand::StartEvent, vtkCommand::EndEvent });
+  m_renderWindow = renderWindow;
   m_layerManager->SetRenderWindow(renderWindow);
+  UpdateAsyncUpdateTimer();
 }
 
 void vtkMRMLLayerDMPipelineManager::SetViewNode(vtkMRMLAbstractViewNode* viewNode)
@@ -99,6 +208,21 @@ void vtkMRMLLayerDMPipelineManager::SetViewNode(vtkMRMLAbstractViewNode* viewNod
   UpdateAllPipelines();
 }
 
+vtkMRMLAbstractViewNode* vtkMRMLLayerDMPipelineManager::GetViewNode() const
+{
+  return m_viewNode;
+}
+
+void vtkMRMLLayerDMPipelineManager::SetInteractionRecorder(vtkMRMLLayerDMInteractionRecorder* recorder)
+{
+  m_interactionRecorder = recorder;
+}
+
+vtkMRMLLayerDMInteractionRecorder* vtkMRMLLayerDMPipelineManager::GetInteractionRecorder() const
+{
+  return m_interactionRecorder;
+}
+
 void vtkMRMLLayerDMPipelineManager::SetFactory(const vtkSmartPointer<vtkMRMLLayerDMPipelineFactory>& factory)
 {
   if (m_factory == factory)
@@ -117,9 +241,26 @@ int vtkMRMLLayerDMPipelineManager::GetMouseCursor() const
   return lastFocused ? lastFocused->GetMouseCursor() : VTK_CURSOR_DEFAULT;
 }
 
+vtkMRMLLayerDMInteractionContext* vtkMRMLLayerDMPipelineManager::GetInteractionContext(vtkRenderer* renderer) const
+{
+  return m_interactionLogic->GetInteractionContext(renderer);
+}
+
+vtkMRMLLayerDMPipelineI* vtkMRMLLayerDMPipelineManager::GetLastFocusedPipeline() const
+{
+  return m_interactionLogic->GetLastFocusedPipeline();
+}
+
 bool vtkMRMLLayerDMPipelineManager::CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2) const
 {
-  return m_interactionLogic->CanProcessInteractionEvent(eventData, distance2);
+  if (m_interactionRecorder)
+  {
+    m_interactionRecorder->RecordEvent(eventData);
+  }
+
+  bool canProcess = m_interactionLogic->CanProcessInteractionEvent(eventData, distance2);
+  RequestRenderForPendingHoverEvent();
+  return canProcess;
 }
 
 void vtkMRMLLayerDMPipelineManager::LoseFocus(vtkMRMLInteractionEventData* eventData) const
@@ -150,57 +291,604 @@ void vtkMRMLLayerDMPipelineManager::ResetCameraClippingRange()
   }
 
   m_isResettingClippingRange = true;
-  m_layerManager->ResetCameraClippingRange();
+  std::array<double, 2> clippingRange{};
+  if (!m_cameraGroup.empty())
+  {
+    // The group camera clipping range is computed once per frame for all the views of the group
+    vtkMRMLLayerDMCameraGroupRegistry::GetInstance()->RequestClippingRangeUpdate(m_cameraGroup);
+    m_defaultCamera->GetClippingRange(clippingRange.data());
+    m_layerManager->ResetCameraClippingRange(clippingRange.data());
+  }
+  else if (m_cameraSync->GetDefaultCameraClippingRange(clippingRange.data()))
+  {
+    m_layerManager->ResetCameraClippingRange(clippingRange.data());
+  }
+  else
+  {
+    m_layerManager->ResetCameraClippingRange();
+  }
   m_isResettingClippingRange = false;
 }
 
 void vtkMRMLLayerDMPipelineManager::RequestRender()
 {
   ResetCameraClippingRange();
+
+  // The render being started already includes the pipelines updated before rendering
+  if (m_isPreparingRender)
+  {
+    return;
+  }
+
+  m_interactionLogic->OnRenderRequested();
+  m_requestRender();
+}
+
+void vtkMRMLLayerDMPipelineManager::RequestObserverFlush()
+{
+  if (m_isObserverFlushRequested)
+  {
+    return;
+  }
+
+  m_isObserverFlushRequested = true;
+  m_interactionLogic->OnRenderRequested();
   m_requestRender();
 }
 
-void vtkMRMLLayerDMPipelineManager::OnDefaultCameraModified() const
+void vtkMRMLLayerDMPipelineManager::ScheduleAsyncUpdate(vtkMRMLLayerDMPipelineI* pipeline)
 {
+  if (!pipeline)
+  {
+    return;
+  }
+
+  // Supersede the running update. Its result will be discarded and the update restarted on completion.
+  auto asyncUpdate = m_asyncUpdates.find(pipeline);
+  if (asyncUpdate != m_asyncUpdates.end())
+  {
+    pipeline->SetAsyncUpdateCancelled(true);
+    asyncUpdate->second.IsRerunNeeded = true;
+    return;
+  }
+
+  m_hasUnsettledUpdates = true;
+  StartAsyncUpdate(pipeline);
+  UpdateAsyncUpdateTimer();
+}
+
+void vtkMRMLLayerDMPipelineManager::StartAsyncUpdate(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline)
+{
+  pipeline->SetAsyncUpdateCancelled(false);
+
+  std::promise<void> promise;
+  auto& asyncUpdate = m_asyncUpdates[pipeline];
+  asyncUpdate.Pipeline = pipeline;
+  asyncUpdate.Future = promise.get_future();
+  asyncUpdate.IsRerunNeeded = false;
+
+  // The pipeline is kept alive by the async update until the worker is joined on the main thread
+  asyncUpdate.Worker = std::thread(
+    [pipeline = pipeline.GetPointer(), promise = std::move(promise)]() mutable
+    {
+      try
+      {
+        pipeline->ComputeUpdateAsync();
+        promise.set_value();
+      }
+      catch (...)
+      {
+        promise.set_exception(std::current_exception());
+      }
+    });
+}
+
+void vtkMRMLLayerDMPipelineManager::ProcessAsyncUpdates()
+{
+  bool isApplied = false;
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> rerunPipelines;
+  for (auto it = m_asyncUpdates.begin(); it != m_asyncUpdates.end();)
+  {
+    auto& asyncUpdate = it->second;
+    if (asyncUpdate.Future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      ++it;
+      continue;
+    }
+
+    asyncUpdate.Worker.join();
+    auto pipeline = asyncUpdate.Pipeline;
+    bool isRerunNeeded = asyncUpdate.IsRerunNeeded;
+    bool isSucceeded = true;
+    try
+    {
+      asyncUpdate.Future.get();
+    }
+    catch (const std::exception& e)
+    {
+      vtkErrorMacro("Asynchronous pipeline update failed: " << e.what());
+      isSucceeded = false;
+    }
+    catch (...)
+    {
+      vtkErrorMacro("Asynchronous pipeline update failed.");
+      isSucceeded = false;
+    }
+    it = m_asyncUpdates.erase(it);
+
+    if (isRerunNeeded)
+    {
+      rerunPipelines.emplace_back(pipeline);
+      continue;
+    }
+
+    // Pipelines removed during the update are not applied
+    bool isManaged = pipeline->GetDisplayNode() && GetNodePipeline(pipeline->GetDisplayNode()) == pipeline;
+    if (isSucceeded && isManaged && !pipeline->IsAsyncUpdateCancelled())
+    {
+      pipeline->ApplyUpdate();
+      isApplied = true;
+    }
+  }
+
+  for (const auto& pipeline : rerunPipelines)
+  {
+    StartAsyncUpdate(pipeline);
+  }
+
+  if (isApplied)
+  {
+    RequestRender();
+  }
+  UpdateAsyncUpdateTimer();
+  InvokeUpdatesSettledEventIfNeeded();
+}
+
+int vtkMRMLLayerDMPipelineManager::GetNumberOfPendingAsyncUpdates() const
+{
+  return static_cast<int>(m_asyncUpdates.size());
+}
+
+void vtkMRMLLayerDMPipelineManager::WaitForAsyncUpdates()
+{
+  while (!m_asyncUpdates.empty())
+  {
+    for (const auto& asyncUpdate : m_asyncUpdates)
+    {
+      asyncUpdate.second.Pipeline->WaitForAsyncUpdate(asyncUpdate.second.Future);
+    }
+    ProcessAsyncUpdates();
+  }
+}
+
+void vtkMRMLLayerDMPipelineManager::SetUpdateBudget(double milliseconds)
+{
+  m_updateBudget = std::max(0., milliseconds);
+  if (m_updateBudget == 0)
+  {
+    FlushScheduledUpdates();
+  }
+}
+
+double vtkMRMLLayerDMPipelineManager::GetUpdateBudget() const
+{
+  return m_updateBudget;
+}
+
+void vtkMRMLLayerDMPipelineManager::ScheduleUpdate(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  SchedulePipelineUpdate(pipeline);
+  InvokeUpdatesSettledEventIfNeeded();
+}
+
+void vtkMRMLLayerDMPipelineManager::SchedulePipelineUpdate(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  if (!pipeline)
+  {
+    return;
+  }
+
+  if (m_updateBudget == 0)
+  {
+    m_hasUnsettledUpdates = true;
+    UpdatePipeline(pipeline);
+    return;
+  }
+
+  if (pipeline->m_isUpdateScheduled)
+  {
+    return;
+  }
+
+  pipeline->m_isUpdateScheduled = true;
+  m_scheduledUpdates.emplace_back(pipeline);
+  m_hasUnsettledUpdates = true;
+
+  // Scheduled updates are processed at the start of the next render.
+  // Updates scheduled while preparing the render are carried over to the next frame by OnRenderStarted.
+  if (m_scheduledUpdates.size() == 1 && !m_isPreparingRender)
+  {
+    m_interactionLogic->OnRenderRequested();
+    m_requestRender();
+  }
+}
+
+int vtkMRMLLayerDMPipelineManager::GetNumberOfScheduledUpdates() const
+{
+  return static_cast<int>(m_scheduledUpdates.size());
+}
+
+void vtkMRMLLayerDMPipelineManager::FlushScheduledUpdates()
+{
+  ProcessScheduledUpdates(0);
+}
+
+void vtkMRMLLayerDMPipelineManager::ProcessScheduledUpdates(double budgetMs)
+{
+  if (m_scheduledUpdates.empty())
+  {
+    return;
+  }
+
+  // Updates requested during the processing are scheduled for the next frame
+  std::vector<std::pair<int, vtkSmartPointer<vtkMRMLLayerDMPipelineI>>> updates;
+  updates.reserve(m_scheduledUpdates.size());
+  for (const auto& pipeline : m_scheduledUpdates)
+  {
+    updates.emplace_back(GetUpdatePriority(pipeline), pipeline);
+  }
+  m_scheduledUpdates.clear();
+  std::stable_sort(updates.begin(), updates.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  // At least one update is processed so that the backlog always drains
+  const auto start = std::chrono::steady_clock::now();
+  auto it = updates.begin();
+  for (; it != updates.end(); ++it)
+  {
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (budgetMs > 0 && it != updates.begin() && elapsedMs >= budgetMs)
+    {
+      break;
+    }
+
+    // Pipelines removed by the previous updates are skipped
+    const auto& pipeline = it->second;
+    if (!pipeline->m_isUpdateScheduled)
+    {
+      continue;
+    }
+    pipeline->m_isUpdateScheduled = false;
+    UpdatePipeline(pipeline);
+  }
+
+  // Carried over updates keep their precedence over the updates requested during the processing
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> carriedOver;
+  for (; it != updates.end(); ++it)
+  {
+    if (it->second->m_isUpdateScheduled)
+    {
+      carriedOver.emplace_back(it->second);
+    }
+  }
+  m_scheduledUpdates.insert(m_scheduledUpdates.begin(), carriedOver.begin(), carriedOver.end());
+  InvokeUpdatesSettledEventIfNeeded();
+}
+
+int vtkMRMLLayerDMPipelineManager::GetUpdatePriority(vtkMRMLLayerDMPipelineI* pipeline) const
+{
+  if (pipeline == m_interactionLogic->GetLastFocusedPipeline())
+  {
+    return FocusedUpdatePriority;
+  }
+
+  // Nodes which are not display nodes don't expose their visibility and are considered visible
+  auto displayNode = vtkMRMLDisplayNode::SafeDownCast(pipeline->GetDisplayNode());
+  if (!displayNode)
+  {
+    return VisibleUpdatePriority;
+  }
+
+  const bool isVisible = displayNode->GetVisibility() && (!m_viewNode || displayNode->IsDisplayableInView(m_viewNode->GetID()));
+  return isVisible ? VisibleUpdatePriority : HiddenUpdatePriority;
+}
+
+void vtkMRMLLayerDMPipelineManager::InvokeUpdatesSettledEventIfNeeded()
+{
+  if (!m_hasUnsettledUpdates || !m_scheduledUpdates.empty() || !m_asyncUpdates.empty())
+  {
+    return;
+  }
+
+  m_hasUnsettledUpdates = false;
+  InvokeEvent(UpdatesSettledEvent);
+}
+
+void vtkMRMLLayerDMPipelineManager::UpdateAsyncUpdateTimer()
+{
+  if (m_asyncUpdates.empty() && m_asyncTimerInteractor)
+  {
+    m_asyncTimerInteractor->DestroyTimer(m_asyncTimerId);
+    m_eventObs->UpdateObserver(m_asyncTimerInteractor, nullptr, vtkCommand::TimerEvent);
+    m_asyncTimerInteractor = nullptr;
+    return;
+  }
+
+  vtkRenderWindowInteractor* interactor = m_renderWindow ? m_renderWindow->GetInteractor() : nullptr;
+  if (m_asyncUpdates.empty() || m_asyncTimerInteractor || !interactor)
+  {
+    return;
+  }
+
+  // Without interactor timer, completed updates are applied at the end of the next render or on WaitForAsyncUpdates
+  m_asyncTimerId = interactor->CreateRepeatingTimer(ASYNC_UPDATE_POLLING_PERIOD_MS);
+  if (m_asyncTimerId != 0)
+  {
+    m_asyncTimerInteractor = interactor;
+    m_eventObs->UpdateObserver(nullptr, interactor, vtkCommand::TimerEvent);
+  }
+}
+
+void vtkMRMLLayerDMPipelineManager::RequestRenderForPendingHoverEvent() const
+{
+  // Coalesced hover events are dispatched at the end of the next render.
+  // Make sure a render is scheduled so that the latest hover event is not lost.
+  if (m_interactionLogic->HasPendingHoverEvent() && !m_interactionLogic->IsRenderPending())
+  {
+    m_interactionLogic->OnRenderRequested();
+    m_requestRender();
+  }
+}
+
+void vtkMRMLLayerDMPipelineManager::FlushObserverEvents()
+{
+  m_isObserverFlushRequested = false;
+  auto observerHub = vtkMRMLLayerDMObserverHub::GetInstance();
+  if (observerHub->HasPendingEvents())
+  {
+    observerHub->Flush();
+  }
+}
+
+void vtkMRMLLayerDMPipelineManager::OnRenderStarted()
+{
+  m_isPreparingRender = true;
+  FlushObserverEvents();
+  ProcessScheduledUpdates(m_updateBudget);
+  if (!m_cameraGroup.empty())
+  {
+    vtkMRMLLayerDMCameraGroupRegistry::GetInstance()->UpdateClippingRange(m_cameraGroup);
+  }
+  NotifyBeforeRender();
+  m_isPreparingRender = false;
+
+  // Scheduled updates exceeding the frame budget are carried over to the next frames
+  if (!m_scheduledUpdates.empty())
+  {
+    m_interactionLogic->OnRenderRequested();
+    m_requestRender();
+  }
+}
+
+void vtkMRMLLayerDMPipelineManager::NotifyBeforeRender()
+{
+  m_renderContext->Update(m_renderWindow, m_defaultCamera, std::exchange(m_frameCameraChanges, vtkMRMLLayerDMPipelineI::CameraNoChange));
+
+  // Pipelines can be added or removed during the notification
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> pipelines;
   for (const auto& pipeline : m_pipelineMap)
   {
-    pipeline.second->OnDefaultCameraModified(m_defaultCamera);
+    const int mask = pipeline.second->GetViewDependencyMask();
+    if (pipeline.second->m_isBeforeRenderRequested || m_renderContext->IsViewChanged(mask))
+    {
+      pipelines.emplace_back(pipeline.second);
+    }
+  }
+
+  for (const auto& pipeline : pipelines)
+  {
+    pipeline->m_isBeforeRenderRequested = false;
+    pipeline->OnBeforeRender(m_renderContext);
+  }
+
+  // Requests made during the notification are processed on the next frame
+  if (std::any_of(pipelines.begin(), pipelines.end(), [](const auto& pipeline) { return pipeline->m_isBeforeRenderRequested; }))
+  {
+    m_interactionLogic->OnRenderRequested();
+    m_requestRender();
   }
 }
 
+void vtkMRMLLayerDMPipelineManager::SetHoverCoalescing(bool isEnabled) const
+{
+  m_interactionLogic->SetHoverCoalescing(isEnabled);
+}
+
+bool vtkMRMLLayerDMPipelineManager::GetHoverCoalescing() const
+{
+  return m_interactionLogic->GetHoverCoalescing();
+}
+
+void vtkMRMLLayerDMPipelineManager::SetMaxHoverDispatchRate(double eventsPerSecond) const
+{
+  m_interactionLogic->SetMaxHoverDispatchRate(eventsPerSecond);
+}
+
+double vtkMRMLLayerDMPipelineManager::GetMaxHoverDispatchRate() const
+{
+  return m_interactionLogic->GetMaxHoverDispatchRate();
+}
+
+void vtkMRMLLayerDMPipelineManager::OnDefaultCameraModified()
+{
+  int cameraChanges = UpdateDefaultCameraState();
+  if (cameraChanges == vtkMRMLLayerDMPipelineI::CameraNoChange)
+  {
+    return;
+  }
+  m_frameCameraChanges |= cameraChanges;
+
+  for (const auto& pipeline : m_pipelineMap)
+  {
+    if (pipeline.second->GetDefaultCameraChangeMask() & cameraChanges)
+    {
+      pipeline.second->OnDefaultCameraChanged(m_defaultCamera, cameraChanges);
+    }
+  }
+}
+
+int vtkMRMLLayerDMPipelineManager::UpdateDefaultCameraState()
+{
+  CameraState state;
+  m_defaultCamera->GetPosition(state.Position.data());
+  m_defaultCamera->GetFocalPoint(state.FocalPoint.data());
+  m_defaultCamera->GetDirectionOfProjection(state.DirectionOfProjection.data());
+  m_defaultCamera->GetViewUp(state.ViewUp.data());
+  m_defaultCamera->GetClippingRange(state.ClippingRange.data());
+  m_defaultCamera->GetWindowCenter(state.WindowCenter.data());
+  state.Distance = m_defaultCamera->GetDistance();
+  state.ViewAngle = m_defaultCamera->GetViewAngle();
+  state.ParallelScale = m_defaultCamera->GetParallelScale();
+  state.IsParallelProjection = m_defaultCamera->GetParallelProjection() != 0;
+
+  const CameraState prev = std::exchange(m_defaultCameraState, state);
+  if (!std::exchange(m_hasDefaultCameraState, true))
+  {
+    return vtkMRMLLayerDMPipelineI::CameraAllChanges;
+  }
+
+  int cameraChanges = vtkMRMLLayerDMPipelineI::CameraNoChange;
+
+  // Dolly changes the displayed size of the perspective projections
+  bool isDistanceChanged = std::abs(prev.Distance - state.Distance) > CAMERA_DERIVED_VALUE_TOLERANCE * std::max(1., prev.Distance);
+  if (prev.IsParallelProjection != state.IsParallelProjection || prev.ViewAngle != state.ViewAngle || prev.ParallelScale != state.ParallelScale
+      || IsChanged(prev.WindowCenter, state.WindowCenter) || (!state.IsParallelProjection && isDistanceChanged))
+  {
+    cameraChanges |= vtkMRMLLayerDMPipelineI::CameraProjectionChange;
+  }
+
+  if (IsChanged(prev.DirectionOfProjection, state.DirectionOfProjection, CAMERA_DERIVED_VALUE_TOLERANCE) || IsChanged(prev.ViewUp, state.ViewUp))
+  {
+    cameraChanges |= vtkMRMLLayerDMPipelineI::CameraOrientationChange;
+  }
+
+  if (IsChanged(prev.Position, state.Position) || IsChanged(prev.FocalPoint, state.FocalPoint))
+  {
+    cameraChanges |= vtkMRMLLayerDMPipelineI::CameraPositionChange;
+  }
+
+  if (IsChanged(prev.ClippingRange, state.ClippingRange))
+  {
+    cameraChanges |= vtkMRMLLayerDMPipelineI::CameraClippingRangeChange;
+  }
+  return cameraChanges;
+}
+
 vtkMRMLLayerDMPipelineManager::vtkMRMLLayerDMPipelineManager()
   : m_factory{ nullptr }
   , m_layerManager(vtkSmartPointer<vtkMRMLLayerDMLayerManager>::New())
   , m_cameraSync(vtkSmartPointer<vtkMRMLLayerDMCameraSynchronizer>::New())
   , m_interactionLogic(vtkSmartPointer<vtkMRMLLayerDMInteractionLogic>::New())
   , m_eventObs(vtkSmartPointer<vtkObjectEventObserver>::New())
-  , m_defaultCamera(vtkSmartPointer<vtkCamera>::New())
+  , m_viewCamera(vtkSmartPointer<vtkCamera>::New())
+  , m_defaultCamera(m_viewCamera)
+  , m_interactionRecorder{ nullptr }
+  , m_renderContext(vtkSmartPointer<vtkMRMLLayerDMRenderContext>::New())
   , m_viewNode{ nullptr }
   , m_scene{ nullptr }
+  , m_renderWindow{ nullptr }
   , m_pipelineMap{}
+  , m_asyncUpdates{}
+  , m_asyncTimerInteractor{ nullptr }
+  , m_asyncTimerId{ 0 }
   , m_requestRender{ [] {} }
+  , m_scheduledUpdates{}
+  , m_updateBudget(0)
+  , m_hasUnsettledUpdates(false)
   , m_isResettingClippingRange(false)
+  , m_isObserverFlushRequested(false)
+  , m_isPreparingRender(false)
+  , m_cameraSyncMode(vtkMRMLLayerDMCameraSynchronizer::SyncChangedParameters)
+  , m_cameraGroup{}
+  , m_defaultCameraState{}
+  , m_hasDefaultCameraState(false)
+  , m_frameCameraChanges(vtkMRMLLayerDMPipelineI::CameraNoChange)
 {
   m_layerManager->SetDefaultCamera(m_defaultCamera);
-  m_cameraSync->SetDefaultCamera(m_defaultCamera);
+  m_cameraSync->SetDefaultCamera(m_viewCamera);
 
   m_eventObs->SetUpdateCallback(
-    [this](vtkObject* obj)
+    [this](vtkObject* obj, unsigned long eventId)
     {
       if (obj == m_factory)
       {
         UpdateFromScene();
       }
 
-      if (obj == m_defaultCamera && !m_isResettingClippingRange)
+      if (obj == m_cameraSync && eventId == vtkCommand::ActiveCameraEvent)
+      {
+        UpdateDefaultCamera();
+      }
+
+      if (obj == m_cameraSync && eventId == vtkCommand::ModifiedEvent)
+      {
+        // Clipping slab thickness changed
+        RequestRender();
+      }
+
+      if (obj == vtkMRMLLayerDMCameraGroupRegistry::GetInstance())
+      {
+        UpdateCameraSynchronization();
+      }
+
+      if (obj == m_defaultCamera && !m_isResettingClippingRange && !IsDefaultCameraSynchronizing())
       {
         ResetCameraClippingRange();
         OnDefaultCameraModified();
       }
+
+      if (obj == m_renderWindow && eventId == vtkCommand::StartEvent)
+      {
+        OnRenderStarted();
+        return;
+      }
+
+      if (obj == m_renderWindow)
+      {
+        m_interactionLogic->OnRenderFinished();
+      }
+
+      if ((obj == m_renderWindow || obj == m_asyncTimerInteractor) && !m_asyncUpdates.empty())
+      {
+        ProcessAsyncUpdates();
+      }
     });
 
   // Monitor camera updates
   m_eventObs->UpdateObserver(nullptr, m_defaultCamera);
+  m_eventObs->UpdateObserver(nullptr, m_cameraSync, { vtkCommand::ActiveCameraEvent, vtkCommand::ModifiedEvent });
+}
+
+vtkMRMLLayerDMPipelineManager::~vtkMRMLLayerDMPipelineManager()
+{
+  auto cameraGroupRegistry = vtkMRMLLayerDMCameraGroupRegistry::GetInstance();
+  m_eventObs->RemoveObjectObservers(cameraGroupRegistry);
+  cameraGroupRegistry->Leave(this);
+
+  // Running updates are cancelled and their workers joined before the pipelines are released
+  for (const auto& asyncUpdate : m_asyncUpdates)
+  {
+    asyncUpdate.second.Pipeline->SetAsyncUpdateCancelled(true);
+  }
+  for (auto& asyncUpdate : m_asyncUpdates)
+  {
+    asyncUpdate.second.Pipeline->WaitForAsyncUpdate(asyncUpdate.second.Future);
+    asyncUpdate.second.Worker.join();
+  }
+
+  if (m_asyncTimerInteractor)
+  {
+    m_asyncTimerInteractor->DestroyTimer(m_asyncTimerId);
+  }
 }
 
 void vtkMRMLLayerDMPipelineManager::UpdatePipeline(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline) const
@@ -237,11 +925,124 @@ void vtkMRMLLayerDMPipelineManager::SetRequestRender(const std::function<void()>
   UpdateAllPipelines();
 }
 
+vtkMRMLLayerDMCellLocatorCache* vtkMRMLLayerDMPipelineManager::GetCellLocatorCache() const
+{
+  return vtkMRMLLayerDMCellLocatorCache::GetInstance();
+}
+
 vtkCamera* vtkMRMLLayerDMPipelineManager::GetDefaultCamera() const
 {
   return m_defaultCamera;
 }
 
+void vtkMRMLLayerDMPipelineManager::SetCameraSyncMode(int syncMode)
+{
+  if (m_cameraSyncMode == syncMode)
+  {
+    return;
+  }
+  m_cameraSyncMode = syncMode;
+  if (m_cameraSyncMode == vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera)
+  {
+    for (const auto& pipeline : m_pipelineMap)
+    {
+      WarnIfSharedCameraConflict(pipeline.second);
+    }
+  }
+  UpdateCameraSynchronization();
+}
+
+int vtkMRMLLayerDMPipelineManager::GetCameraSyncMode() const
+{
+  return m_cameraSyncMode;
+}
+
+void vtkMRMLLayerDMPipelineManager::SetSliceClippingSlabThickness(double relativeThickness)
+{
+  m_cameraSync->SetSliceClippingSlabThickness(relativeThickness);
+}
+
+double vtkMRMLLayerDMPipelineManager::GetSliceClippingSlabThickness() const
+{
+  return m_cameraSync->GetSliceClippingSlabThickness();
+}
+
+void vtkMRMLLayerDMPipelineManager::SetCameraGroup(const std::string& groupName)
+{
+  if (m_cameraGroup == groupName)
+  {
+    return;
+  }
+
+  auto cameraGroupRegistry = vtkMRMLLayerDMCameraGroupRegistry::GetInstance();
+  m_eventObs->RemoveObjectObservers(cameraGroupRegistry);
+  cameraGroupRegistry->Leave(this);
+
+  m_cameraGroup = groupName;
+  if (cameraGroupRegistry->Join(m_cameraGroup, this))
+  {
+    // Monitor the group members to take over the group camera synchronization
+    m_eventObs->AddEventObserver(cameraGroupRegistry, vtkCommand::ModifiedEvent);
+  }
+  UpdateCameraSynchronization();
+}
+
+std::string vtkMRMLLayerDMPipelineManager::GetCameraGroup() const
+{
+  return m_cameraGroup;
+}
+
+void vtkMRMLLayerDMPipelineManager::UpdateCameraSynchronization()
+{
+  auto cameraGroupRegistry = vtkMRMLLayerDMCameraGroupRegistry::GetInstance();
+  vtkCamera* groupCamera = cameraGroupRegistry->GetGroupCamera(m_cameraGroup);
+  if (!groupCamera)
+  {
+    m_cameraSync->SetDefaultCamera(m_viewCamera);
+    m_cameraSync->SetSyncMode(m_cameraSyncMode);
+  }
+  else
+  {
+    // The group camera is read by all the views of the group and can't be shared with the synchronizing view
+    const bool isSynchronizer = cameraGroupRegistry->GetGroupSynchronizer(m_cameraGroup) == this;
+    m_cameraSync->SetDefaultCamera(isSynchronizer ? groupCamera : nullptr);
+    m_cameraSync->SetSyncMode(m_cameraSyncMode == vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera ? vtkMRMLLayerDMCameraSynchronizer::SyncChangedParameters
+                                                                                                  : m_cameraSyncMode);
+  }
+  UpdateDefaultCamera();
+}
+
+void vtkMRMLLayerDMPipelineManager::WarnIfSharedCameraConflict(vtkMRMLLayerDMPipelineI* pipeline)
+{
+  if (pipeline && pipeline->GetCamera())
+  {
+    vtkWarningMacro("" << __func__ << ": Pipeline " << pipeline->GetClassName()
+                       << " uses its own camera. SyncSharedCamera is only meant for views where all the pipelines render with the view camera.");
+  }
+}
+
+bool vtkMRMLLayerDMPipelineManager::IsDefaultCameraSynchronizing() const
+{
+  auto synchronizer = m_cameraGroup.empty() ? this : vtkMRMLLayerDMCameraGroupRegistry::GetInstance()->GetGroupSynchronizer(m_cameraGroup);
+  return synchronizer && synchronizer->m_cameraSync->IsSynchronizing();
+}
+
+void vtkMRMLLayerDMPipelineManager::UpdateDefaultCamera()
+{
+  vtkCamera* groupCamera = vtkMRMLLayerDMCameraGroupRegistry::GetInstance()->GetGroupCamera(m_cameraGroup);
+  vtkCamera* camera = groupCamera ? groupCamera : m_cameraSync->GetSynchronizedCamera();
+  if (!camera || camera == m_defaultCamera)
+  {
+    return;
+  }
+
+  m_eventObs->UpdateObserver(m_defaultCamera, camera);
+  m_defaultCamera = camera;
+  m_layerManager->SetDefaultCamera(m_defaultCamera);
+  OnDefaultCameraModified();
+  RequestRender();
+}
+
 void vtkMRMLLayerDMPipelineManager::RemoveOutdatedPipelines()
 {
   if (!m_scene)
@@ -260,19 +1061,45 @@ void vtkMRMLLayerDMPipelineManager::RemoveOutdatedPipelines()
 
 void vtkMRMLLayerDMPipelineManager::AddMissingPipelines()
 {
-  if (!m_scene)
+  if (!m_scene || !m_factory || !m_viewNode)
   {
     return;
   }
 
+  // Gather the nodes without pipeline and create their pipelines in a single factory call
+  std::vector<vtkMRMLNode*> nodes;
   int nNodes = m_scene->GetNumberOfNodes();
+  nodes.reserve(nNodes);
   for (int iNode = 0; iNode < nNodes; iNode++)
   {
-    if (auto node = vtkMRMLNode::SafeDownCast(m_scene->GetNodes()->GetItemAsObject(iNode)))
+    auto node = vtkMRMLNode::SafeDownCast(m_scene->GetNodes()->GetItemAsObject(iNode));
+    if (node && !GetNodePipeline(node))
     {
-      AddNode(node);
+      nodes.emplace_back(node);
     }
   }
+
+  if (nodes.empty())
+  {
+    return;
+  }
+
+  auto pipelines = m_factory->CreatePipelines(m_viewNode, nodes);
+  bool isModified = false;
+  for (size_t iNode = 0; iNode < std::min(nodes.size(), pipelines.size()); ++iNode)
+  {
+    if (pipelines[iNode])
+    {
+      AddPipeline(nodes[iNode], pipelines[iNode]);
+      isModified = true;
+    }
+  }
+
+  if (isModified)
+  {
+    InvokeEvent(vtkCommand::ModifiedEvent);
+  }
+  InvokeUpdatesSettledEventIfNeeded();
 }
 
 void vtkMRMLLayerDMPipelineManager::UpdateFromScene()
@@ -3,26 +3,38 @@
 #include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
 
 #include <vtkObject.h>
+#include <vtkWrappingHints.h>
 #include <vtkWeakPointer.h>
 #include <vtkSmartPointer.h>
 
+#include <array>
 #include <functional>
+#include <future>
 #include <map>
+#include <string>
+#include <thread>
+#include <vector>
 #include <vtkCommand.h>
 
 class vtkCamera;
 class vtkMRMLAbstractViewNode;
 class vtkMRMLInteractionEventData;
+class vtkMRMLLayerDMCameraGroupRegistry;
 class vtkMRMLLayerDMCameraSynchronizer;
+class vtkMRMLLayerDMCellLocatorCache;
+class vtkMRMLLayerDMInteractionContext;
 class vtkMRMLLayerDMInteractionLogic;
+class vtkMRMLLayerDMInteractionRecorder;
 class vtkMRMLLayerDMLayerManager;
 class vtkMRMLLayerDMPipelineCreatorI;
 class vtkMRMLLayerDMPipelineFactory;
 class vtkMRMLLayerDMPipelineI;
+class vtkMRMLLayerDMRenderContext;
 class vtkMRMLNode;
 class vtkMRMLScene;
 class vtkObjectEventObserver;
 class vtkRenderWindow;
+class vtkRenderWindowInteractor;
 class vtkRenderer;
 
 /// @brief Class responsible for handling adding / updating / removing pipelines depending on nodes added / removed /
@@ -32,6 +44,14 @@ class vtkRenderer;
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMPipelineManager : public vtkObject
 {
 public:
+  enum Events
+  {
+    // Triggered when the scheduled pipeline updates and the asynchronous updates have all been applied.
+    // With an update budget of 0, triggered once the immediate updates of a batch (scene synchronization, pipeline
+    // creation, \sa UpdateAllPipelines or \sa ScheduleUpdate call) are applied and no asynchronous update is pending.
+    UpdatesSettledEvent = vtkCommand::UserEvent + 1
+  };
+
   static vtkMRMLLayerDMPipelineManager* New();
   vtkTypeMacro(vtkMRMLLayerDMPipelineManager, vtkObject);
 
@@ -47,17 +67,54 @@ public:
   /// Delegates to \sa vtkMRMLLayerDMPipelineFactory::CreatePipeline.
   bool CreatePipelineForNode(vtkMRMLNode* displayNode);
 
+  /// Returns the cell locator cache shared by the pipelines of all the views.
+  /// \sa vtkMRMLLayerDMCellLocatorCache::GetInstance
+  vtkMRMLLayerDMCellLocatorCache* GetCellLocatorCache() const;
+
   /// Returns the default camera for the pipeline.
   /// The camera synchronization is handled by \sa vtkMRMLLayerDMCameraSynchronizer.
+  /// In \sa vtkMRMLLayerDMCameraSynchronizer::SyncSharedCamera mode, the default camera is the renderer camera.
   vtkCamera* GetDefaultCamera() const;
 
+  /// @{
+  /// Delegates the default camera synchronization mode to \sa vtkMRMLLayerDMCameraSynchronizer
+  /// Views of a camera group copy the group camera, SyncSharedCamera is used as SyncChangedParameters.
+  /// A warning is reported if SyncSharedCamera is used with pipelines returning their own camera.
+  void SetCameraSyncMode(int syncMode);
+  int GetCameraSyncMode() const;
+  /// @}
+
+  /// @{
+  /// Delegates the slice view clipping slab thickness to \sa vtkMRMLLayerDMCameraSynchronizer.
+  /// The clipping range is reset and a render is requested when the thickness changes.
+  void SetSliceClippingSlabThickness(double relativeThickness);
+  double GetSliceClippingSlabThickness() const;
+  /// @}
+
+  /// @{
+  /// Join the camera group of the linked views sharing the same default camera.
+  /// The camera synchronization and the default camera clipping range are computed once for the group.
+  /// Empty group name to leave the current group (default).
+  /// \sa vtkMRMLLayerDMCameraGroupRegistry
+  void SetCameraGroup(const std::string& groupName);
+  std::string GetCameraGroup() const;
+  /// @}
+
   /// Clear all pipelines from the pipeline manager.
   /// Should be called at delete.
   void ClearDisplayableNodes();
 
+  /// Returns the interaction context of the input renderer for the event being processed.
+  /// Delegates to \sa vtkMRMLLayerDMInteractionLogic::GetInteractionContext.
+  vtkMRMLLayerDMInteractionContext* GetInteractionContext(vtkRenderer* renderer) const;
+
   /// Returns the mouse cursor from the latest pipeline having handled the latest interaction.
   int GetMouseCursor() const;
 
+  /// Returns the latest pipeline having handled the latest interaction.
+  /// nullptr if no pipeline has the focus.
+  vtkMRMLLayerDMPipelineI* GetLastFocusedPipeline() const;
+
   /// Returns the pipeline associated with the input display node if any.
   vtkSmartPointer<vtkMRMLLayerDMPipelineI> GetNodePipeline(vtkMRMLNode* node) const;
 
@@ -77,17 +134,29 @@ public:
   ///@}
 
   /// Reset camera clipping range and call display manager request render.
-  void RequestRender();
+  /// The python GIL is released during the call.
+  VTK_UNBLOCKTHREADS void RequestRender();
+
+  /// Schedule a render flushing the events coalesced by \sa vtkMRMLLayerDMObserverHub before rendering.
+  /// Called by the observer hub when an event is coalesced for one of the pipelines of the manager.
+  /// Render requests of the pipelines updated during the flush are included in the starting render.
+  void RequestObserverFlush();
 
   /// Delegate to \sa vtkMRMLLayerDMLayerManager::ResetCameraClippingRange
-  void ResetCameraClippingRange();
+  /// The default camera clipping range provided by \sa vtkMRMLLayerDMCameraSynchronizer is used when available
+  /// (slice views) instead of computing the layers visible bounds.
+  /// The python GIL is released during the call.
+  VTK_UNBLOCKTHREADS void ResetCameraClippingRange();
 
   /// Set the Pipeline factory to use by the pipeline manager (initialization).
   /// On factory-modified event, will trigger a \sa UpdateFromScene.
   void SetFactory(const vtkSmartPointer<vtkMRMLLayerDMPipelineFactory>& factory);
 
   /// Set the render window on which the pipeline manager is attached (initialization).
-  void SetRenderWindow(vtkRenderWindow* renderWindow) const;
+  /// The render window start of render is monitored to flush the coalesced observer events and to call
+  /// \sa vtkMRMLLayerDMPipelineI::OnBeforeRender once per frame. The end of render is monitored to flush coalesced
+  /// hover events.
+  void SetRenderWindow(vtkRenderWindow* renderWindow);
 
   /// Set the default renderer used by the display manager (initialization).
   void SetRenderer(vtkRenderer* renderer) const;
@@ -101,8 +170,73 @@ public:
   /// Set the view node (initialization).
   void SetViewNode(vtkMRMLAbstractViewNode* viewNode);
 
+  /// Returns the current view node.
+  vtkMRMLAbstractViewNode* GetViewNode() const;
+
+  /// @{
+  /// Set the recorder receiving the events of \sa CanProcessInteractionEvent.
+  /// Set to nullptr to disable recording (default).
+  void SetInteractionRecorder(vtkMRMLLayerDMInteractionRecorder* recorder);
+  vtkMRMLLayerDMInteractionRecorder* GetInteractionRecorder() const;
+  /// @}
+
+  /// @{
+  /// Delegates hover event coalescing configuration to \sa vtkMRMLLayerDMInteractionLogic
+  void SetHoverCoalescing(bool isEnabled) const;
+  bool GetHoverCoalescing() const;
+  void SetMaxHoverDispatchRate(double eventsPerSecond) const;
+  double GetMaxHoverDispatchRate() const;
+  /// @}
+
+  /// Move the input pipeline to the renderer matching its current render layer and camera and request a render.
+  /// Delegates to \sa vtkMRMLLayerDMLayerManager::UpdatePipelineLayer.
+  void UpdatePipelineLayer(vtkMRMLLayerDMPipelineI* pipeline);
+
+  /// Schedule the asynchronous update of the input pipeline.
+  /// \sa vtkMRMLLayerDMPipelineI::ComputeUpdateAsync is executed on a worker thread. On completion,
+  /// \sa vtkMRMLLayerDMPipelineI::ApplyUpdate is called on the main thread and a render is requested.
+  /// If an update of the pipeline is already running, it is cancelled and a new update is started on its completion.
+  /// Completed updates are polled using the render window interactor timer and at the end of each render.
+  void ScheduleAsyncUpdate(vtkMRMLLayerDMPipelineI* pipeline);
+
+  /// Apply the completed asynchronous updates and start the superseding ones.
+  /// Called on the main thread.
+  void ProcessAsyncUpdates();
+
+  /// Number of asynchronous updates running or waiting to be applied.
+  int GetNumberOfPendingAsyncUpdates() const;
+
+  /// Block until all the asynchronous updates are completed and applied.
+  /// Waits through \sa vtkMRMLLayerDMPipelineI::WaitForAsyncUpdate.
+  /// The python GIL is released during the call.
+  VTK_UNBLOCKTHREADS void WaitForAsyncUpdates();
+
+  /// @{
+  /// Time budget in milliseconds of the scheduled pipeline updates processed at the start of each render.
+  /// When positive, the pipeline updates triggered by the scene synchronization, the view node changes and
+  /// \sa vtkMRMLLayerDMPipelineI::RequestUpdate are scheduled instead of being applied immediately.
+  /// Renderer changes keep updating the pipelines immediately, unless their update is already scheduled.
+  /// Each frame updates the focused pipeline first, then the visible pipelines and the hidden ones, until the budget is
+  /// spent. At least one update is processed per frame and the remaining updates are carried over to the next frames.
+  /// 0 to update the pipelines immediately (default).
+  void SetUpdateBudget(double milliseconds);
+  double GetUpdateBudget() const;
+  /// @}
+
+  /// Schedule the update of the input pipeline on the next frame.
+  /// Requests for a pipeline already scheduled are coalesced. Updates the pipeline immediately if the update budget is 0.
+  void ScheduleUpdate(vtkMRMLLayerDMPipelineI* pipeline);
+
+  /// Number of scheduled pipeline updates carried over to the next frames.
+  int GetNumberOfScheduledUpdates() const;
+
+  /// Apply all the scheduled pipeline updates regardless of the update budget.
+  /// Updates requested during the flush are scheduled for the next frame.
+  void FlushScheduledUpdates();
+
   /// Update all pipelines managed by the pipeline manager.
-  void UpdateAllPipelines() const;
+  /// The updates are scheduled if the update budget is positive.
+  void UpdateAllPipelines();
 
   /// Update the pipeline manager from the current MRML scene state.
   /// Will automatically remove or create pipelines depending on the scene state.
@@ -110,33 +244,138 @@ public:
 
 protected:
   vtkMRMLLayerDMPipelineManager();
-  ~vtkMRMLLayerDMPipelineManager() override = default;
+  ~vtkMRMLLayerDMPipelineManager() override;
 
 private:
-  /// Notify pipelines that the default camera has changed.
-  void OnDefaultCameraModified() const;
+  friend class vtkMRMLLayerDMCameraGroupRegistry;
+
+  /// Notify the pipelines subscribed to the default camera components which have changed.
+  void OnDefaultCameraModified();
+
+  /// Use the camera synchronized by the camera synchronizer or the camera of the camera group as default camera.
+  /// Called when the synchronizer starts or stops sharing the renderer camera and when the camera group changes.
+  void UpdateDefaultCamera();
+
+  /// Configure the camera synchronizer depending on the sync mode and the camera group.
+  /// Only the first view of a camera group synchronizes the group camera.
+  void UpdateCameraSynchronization();
+
+  /// Warn if the input pipeline uses its own camera while the default camera is shared with the renderer.
+  void WarnIfSharedCameraConflict(vtkMRMLLayerDMPipelineI* pipeline);
+
+  /// true while the default camera is being updated by the synchronizer of the view or of the camera group.
+  bool IsDefaultCameraSynchronizing() const;
+
+  /// Store the current default camera state.
+  /// \return the \sa vtkMRMLLayerDMPipelineI::CameraChange components changed since the previous call.
+  int UpdateDefaultCameraState();
 
   /// Update the input pipeline and reset its display.
   void UpdatePipeline(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline) const;
 
+  /// Update the scheduled pipelines by priority until the input budget in milliseconds is spent.
+  /// A budget of 0 updates all the scheduled pipelines.
+  void ProcessScheduledUpdates(double budgetMs);
+
+  /// Priority of the scheduled update of the input pipeline, lower values are updated first.
+  int GetUpdatePriority(vtkMRMLLayerDMPipelineI* pipeline) const;
+
+  /// Invoke \sa UpdatesSettledEvent if updates were scheduled since the previous event and none is pending anymore.
+  void InvokeUpdatesSettledEventIfNeeded();
+
+  /// Schedule the update of the input pipeline, or update it immediately if the update budget is 0.
+  /// \sa UpdatesSettledEvent is left to the caller, once its whole batch of updates is scheduled.
+  void SchedulePipelineUpdate(vtkMRMLLayerDMPipelineI* pipeline);
+
   /// Remove pipelines with nodes not present in the scene anymore.
   void RemoveOutdatedPipelines();
 
   /// Add pipelines for nodes not currently handled by the pipeline manager.
+  /// Pipelines are created in a single batch using \sa vtkMRMLLayerDMPipelineFactory::CreatePipelines.
   void AddMissingPipelines();
 
+  /// Initialize the input pipeline created for the display node and add it to the managed pipelines.
+  void AddPipeline(vtkMRMLNode* displayNode, const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline);
+
+  /// Start the worker thread of the input pipeline asynchronous update.
+  /// The worker is owned by the pipeline manager and joined once its update is processed.
+  void StartAsyncUpdate(const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& pipeline);
+
+  /// Start or stop the interactor timer polling the asynchronous updates depending on the pending updates.
+  void UpdateAsyncUpdateTimer();
+
+  /// Request a render if a coalesced hover event is waiting for the next render to be dispatched.
+  void RequestRenderForPendingHoverEvent() const;
+
+  /// Prepare the pipelines for the starting render.
+  /// Flushes the coalesced observer events, processes the scheduled updates within the update budget and notifies the
+  /// pipelines before render.
+  void OnRenderStarted();
+
+  /// Deliver the events coalesced by the observer hub before the render starts.
+  void FlushObserverEvents();
+
+  /// Update the render context and call \sa vtkMRMLLayerDMPipelineI::OnBeforeRender on the pipelines whose
+  /// view-dependent inputs changed since the previous frame or which requested it.
+  void NotifyBeforeRender();
+
   vtkSmartPointer<vtkMRMLLayerDMPipelineFactory> m_factory;
   vtkSmartPointer<vtkMRMLLayerDMLayerManager> m_layerManager;
   vtkSmartPointer<vtkMRMLLayerDMCameraSynchronizer> m_cameraSync;
   vtkSmartPointer<vtkMRMLLayerDMInteractionLogic> m_interactionLogic;
   vtkSmartPointer<vtkObjectEventObserver> m_eventObs;
+  vtkSmartPointer<vtkCamera> m_viewCamera;
   vtkSmartPointer<vtkCamera> m_defaultCamera;
+  vtkSmartPointer<vtkMRMLLayerDMInteractionRecorder> m_interactionRecorder;
+  vtkSmartPointer<vtkMRMLLayerDMRenderContext> m_renderContext;
 
   vtkWeakPointer<vtkMRMLAbstractViewNode> m_viewNode;
   vtkWeakPointer<vtkMRMLScene> m_scene;
+  vtkWeakPointer<vtkRenderWindow> m_renderWindow;
 
   std::map<vtkWeakPointer<vtkMRMLNode>, vtkSmartPointer<vtkMRMLLayerDMPipelineI>> m_pipelineMap;
+
+  // The worker only uses the pipeline kept alive by the update so that the pipeline is always released on the main
+  // thread. Workers are joined when their update is processed or on destruction.
+  struct AsyncUpdate
+  {
+    vtkSmartPointer<vtkMRMLLayerDMPipelineI> Pipeline;
+    std::future<void> Future;
+    std::thread Worker;
+    bool IsRerunNeeded{ false };
+  };
+  std::map<vtkMRMLLayerDMPipelineI*, AsyncUpdate> m_asyncUpdates;
+  vtkWeakPointer<vtkRenderWindowInteractor> m_asyncTimerInteractor;
+  int m_asyncTimerId;
   std::function<void()> m_requestRender;
 
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> m_scheduledUpdates;
+  double m_updateBudget;
+  bool m_hasUnsettledUpdates;
+
+  struct CameraState
+  {
+    std::array<double, 3> Position{};
+    std::array<double, 3> FocalPoint{};
+    std::array<double, 3> DirectionOfProjection{};
+    std::array<double, 3> ViewUp{};
+    std::array<double, 2> ClippingRange{};
+    std::array<double, 2> WindowCenter{};
+    double Distance{ 0 };
+    double ViewAngle{ 0 };
+    double ParallelScale{ 0 };
+    bool IsParallelProjection{ false };
+  };
+  CameraState m_defaultCameraState;
+  bool m_hasDefaultCameraState;
+
+  // Camera components changed since the previous frame
+  int m_frameCameraChanges;
+
   bool m_isResettingClippingRange;
+  bool m_isObserverFlushRequested;
+  bool m_isPreparingRender;
+
+  int m_cameraSyncMode;
+  std::string m_cameraGroup;
 };
@@ -5,14 +5,16 @@
 #include "vtkMRMLNode.h"
 
 #include <vtkObjectFactory.h>
-#include <vtkSmartPyObject.h>
 #include <vtkPythonUtil.h>
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkMRMLLayerDMPipelineScriptedCreator);
 
 vtkMRMLLayerDMPipelineScriptedCreator::vtkMRMLLayerDMPipelineScriptedCreator()
-  : m_object(nullptr)
+  : m_object{}
+  , m_batchObject{}
 {
   SetCallback(
     [this](vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node) -> vtkSmartPointer<vtkMRMLLayerDMPipelineI>
@@ -24,13 +26,12 @@ vtkMRMLLayerDMPipelineScriptedCreator::vtkMRMLLayerDMPipelineScriptedCreator()
 
       vtkPythonScopeGilEnsurer gilEnsurer;
 
-      PyObject* pyViewNode = vtkPythonUtil::GetObjectFromPointer(viewNode);
-      PyObject* pyNode = vtkPythonUtil::GetObjectFromPointer(node);
-      vtkSmartPyObject pyArgs(PyTuple_Pack(2, pyViewNode, pyNode));
+      layer_dm::PythonReference pyViewNode(vtkPythonUtil::GetObjectFromPointer(viewNode));
+      layer_dm::PythonReference pyNode(vtkPythonUtil::GetObjectFromPointer(node));
+      layer_dm::PythonReference pyArgs(PyTuple_Pack(2, pyViewNode.Get(), pyNode.Get()));
 
-      Py_XDECREF(pyViewNode);
-      Py_XDECREF(pyNode);
-      PyObject* result = PyObject_CallObject(m_object, pyArgs);
+      // The returned pipeline is kept alive by the smart pointer once the python result is released
+      layer_dm::PythonReference result(PyObject_CallObject(m_object, pyArgs));
       if (!result)
       {
         PyErr_Print();
@@ -45,11 +46,119 @@ vtkMRMLLayerDMPipelineScriptedCreator::~vtkMRMLLayerDMPipelineScriptedCreator()
   if (Py_IsInitialized())
   {
     vtkPythonScopeGilEnsurer gilEnsurer;
-    Py_XDECREF(m_object);
+    m_object.Reset();
+    m_batchObject.Reset();
   }
 }
 
+vtkSmartPointer<vtkMRMLLayerDMPipelineI> vtkMRMLLayerDMPipelineScriptedCreator::CreatePipeline(vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node) const
+{
+  if (!IsNodeClassHandled(node))
+  {
+    return nullptr;
+  }
+  return Superclass::CreatePipeline(viewNode, node);
+}
+
+std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> vtkMRMLLayerDMPipelineScriptedCreator::CreatePipelines(vtkMRMLAbstractViewNode* viewNode,
+                                                                                                             const std::vector<vtkMRMLNode*>& nodes) const
+{
+  if (!Py_IsInitialized() || !m_batchObject || !PyCallable_Check(m_batchObject))
+  {
+    return Superclass::CreatePipelines(viewNode, nodes);
+  }
+
+  // Only send the nodes matching the declared node classes to python
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> pipelines(nodes.size());
+  std::vector<size_t> candidates;
+  candidates.reserve(nodes.size());
+  for (size_t iNode = 0; iNode < nodes.size(); ++iNode)
+  {
+    if (IsNodeClassHandled(nodes[iNode]))
+    {
+      candidates.emplace_back(iNode);
+    }
+  }
+
+  if (candidates.empty())
+  {
+    return pipelines;
+  }
+
+  vtkPythonScopeGilEnsurer gilEnsurer;
+
+  // PyList_SET_ITEM steals the node references
+  layer_dm::PythonReference pyNodes(PyList_New(static_cast<Py_ssize_t>(candidates.size())));
+  for (size_t iCandidate = 0; iCandidate < candidates.size(); ++iCandidate)
+  {
+    PyList_SET_ITEM(pyNodes.Get(), static_cast<Py_ssize_t>(iCandidate), vtkPythonUtil::GetObjectFromPointer(nodes[candidates[iCandidate]]));
+  }
+
+  layer_dm::PythonReference pyViewNode(vtkPythonUtil::GetObjectFromPointer(viewNode));
+  layer_dm::PythonReference pyArgs(PyTuple_Pack(2, pyViewNode.Get(), pyNodes.Get()));
+
+  layer_dm::PythonReference result(PyObject_CallObject(m_batchObject, pyArgs));
+  if (!result)
+  {
+    PyErr_Print();
+    return pipelines;
+  }
+
+  layer_dm::PythonReference sequence(PySequence_Fast(result, "Expected a list of pipelines return type"));
+  if (!sequence || (PySequence_Fast_GET_SIZE(sequence.Get()) != static_cast<Py_ssize_t>(candidates.size())))
+  {
+    PyErr_Clear();
+    vtkErrorMacro("" << __func__ << ": Batch callback is expected to return one pipeline or None per input node.");
+    return pipelines;
+  }
+
+  for (size_t iCandidate = 0; iCandidate < candidates.size(); ++iCandidate)
+  {
+    PyObject* item = PySequence_Fast_GET_ITEM(sequence.Get(), static_cast<Py_ssize_t>(iCandidate));
+    if (item && (item != Py_None))
+    {
+      pipelines[candidates[iCandidate]] = vtkMRMLLayerDMPipelineI::SafeDownCast(vtkPythonUtil::GetPointerFromObject(item, "vtkMRMLLayerDMPipelineI"));
+    }
+  }
+  PyErr_Clear();
+  return pipelines;
+}
+
 void vtkMRMLLayerDMPipelineScriptedCreator::SetPythonCallback(PyObject* object)
+{
+  SetPythonObject(m_object, object);
+}
+
+void vtkMRMLLayerDMPipelineScriptedCreator::SetPythonBatchCallback(PyObject* object)
+{
+  SetPythonObject(m_batchObject, object);
+}
+
+void vtkMRMLLayerDMPipelineScriptedCreator::AddNodeClassName(const std::string& className)
+{
+  if (className.empty() || std::find(m_nodeClassNames.begin(), m_nodeClassNames.end(), className) != m_nodeClassNames.end())
+  {
+    return;
+  }
+  m_nodeClassNames.emplace_back(className);
+}
+
+void vtkMRMLLayerDMPipelineScriptedCreator::ClearNodeClassNames()
+{
+  m_nodeClassNames.clear();
+}
+
+bool vtkMRMLLayerDMPipelineScriptedCreator::IsNodeClassHandled(vtkMRMLNode* node) const
+{
+  if (m_nodeClassNames.empty())
+  {
+    return true;
+  }
+
+  return node && std::any_of(m_nodeClassNames.begin(), m_nodeClassNames.end(), [node](const std::string& className) { return node->IsA(className.c_str()); });
+}
+
+void vtkMRMLLayerDMPipelineScriptedCreator::SetPythonObject(layer_dm::PythonReference& target, PyObject* object)
 {
   if (!Py_IsInitialized())
   {
@@ -58,13 +167,11 @@ void vtkMRMLLayerDMPipelineScriptedCreator::SetPythonCallback(PyObject* object)
   }
 
   vtkPythonScopeGilEnsurer gilEnsurer;
-  if (m_object == object)
+  if (target == object)
   {
     return;
   }
 
   // Set the new python lambda
-  Py_XDECREF(m_object);
-  m_object = object;
-  Py_INCREF(m_object);
+  target = layer_dm::PythonReference::FromBorrowed(object);
 }
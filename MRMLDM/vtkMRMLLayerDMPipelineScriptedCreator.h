@@ -2,23 +2,54 @@
 
 #include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
 #include "vtkMRMLLayerDMPipelineCallbackCreator.h"
+#include "vtkMRMLLayerDMPythonReference.h"
 
 #include <vtkPython.h>
 
+#include <string>
+#include <vector>
+
 /// Python lambda implementation of \sa vtkMRMLLayerDMPipelineCallbackCreator
 /// Delegates callback to underlying Python callable object.
+///
+/// An optional batch callback can be set using \sa SetPythonBatchCallback. During full scene synchronization, the
+/// batch callback is called once with the list of candidate nodes instead of calling the callback for each node.
+///
+/// Candidate nodes can be pre-filtered in C++ by declaring the node classes handled by the creator using
+/// \sa AddNodeClassName. Nodes not matching any declared class are not sent to Python.
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMPipelineScriptedCreator : public vtkMRMLLayerDMPipelineCallbackCreator
 {
 public:
   static vtkMRMLLayerDMPipelineScriptedCreator* New();
 
   vtkTypeMacro(vtkMRMLLayerDMPipelineScriptedCreator, vtkMRMLLayerDMPipelineCallbackCreator);
+
+  vtkSmartPointer<vtkMRMLLayerDMPipelineI> CreatePipeline(vtkMRMLAbstractViewNode* viewNode, vtkMRMLNode* node) const override;
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> CreatePipelines(vtkMRMLAbstractViewNode* viewNode,
+                                                                        const std::vector<vtkMRMLNode*>& nodes) const override;
   void SetPythonCallback(PyObject* object);
 
+  /// Set the python callable creating the pipelines of a list of nodes in a single call.
+  /// Expected signature: (viewNode, nodes: list[vtkMRMLNode]) -> list[vtkMRMLLayerDMPipelineI | None]
+  /// The returned list is expected to have the same length as the input nodes.
+  void SetPythonBatchCallback(PyObject* object);
+
+  /// @{
+  /// Node classes handled by the creator.
+  /// If not empty, only the nodes deriving from one of the classes are sent to the python callbacks.
+  void AddNodeClassName(const std::string& className);
+  void ClearNodeClassNames();
+  /// @}
+
 protected:
   vtkMRMLLayerDMPipelineScriptedCreator();
   ~vtkMRMLLayerDMPipelineScriptedCreator() override;
 
 private:
-  PyObject* m_object;
-};
\ No newline at end of file
+  bool IsNodeClassHandled(vtkMRMLNode* node) const;
+  void SetPythonObject(layer_dm::PythonReference& target, PyObject* object);
+
+  layer_dm::PythonReference m_object;
+  layer_dm::PythonReference m_batchObject;
+  std::vector<std::string> m_nodeClassNames;
+};
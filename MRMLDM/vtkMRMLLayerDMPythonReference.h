@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vtkPython.h>
+
+#include <atomic>
+#include <utility>
+
+#ifndef __VTK_WRAP__
+
+namespace layer_dm
+{
+/// \brief Owning reference to a python object held by the python bridge classes.
+///
+/// Steals the input reference on construction and releases it on destruction, reset or move assignment.
+/// The GIL is expected to be held when a non-empty reference is created, reset or destroyed while the interpreter is
+/// initialized.
+///
+/// The number of live references is tracked process-wide to detect the leaks of the python bridge classes.
+/// \sa vtkMRMLLayerDMScriptedPipelineBridge::GetNumberOfLivePythonReferences
+class PythonReference
+{
+public:
+  PythonReference() = default;
+
+  /// Take ownership of the input new reference.
+  explicit PythonReference(PyObject* object)
+    : m_object{ object }
+  {
+    Track();
+  }
+
+  /// Create a new owning reference from the input borrowed reference.
+  static PythonReference FromBorrowed(PyObject* object)
+  {
+    Py_XINCREF(object);
+    return PythonReference(object);
+  }
+
+  PythonReference(const PythonReference&) = delete;
+  PythonReference& operator=(const PythonReference&) = delete;
+
+  PythonReference(PythonReference&& other) noexcept
+    : m_object{ std::exchange(other.m_object, nullptr) }
+  {
+  }
+
+  PythonReference& operator=(PythonReference&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Reset(other.Release());
+    }
+    return *this;
+  }
+
+  ~PythonReference() { Reset(); }
+
+  /// Release the current reference and take ownership of the input new reference.
+  void Reset(PyObject* object = nullptr)
+  {
+    PyObject* prev = std::exchange(m_object, object);
+    Track();
+    if (prev)
+    {
+      // Objects can't be released anymore once the interpreter is finalized
+      --s_nLiveReferences;
+      if (Py_IsInitialized())
+      {
+        Py_DECREF(prev);
+      }
+    }
+  }
+
+  /// Give up the ownership of the reference to the caller (for instance to a stealing python API).
+  PyObject* Release()
+  {
+    if (m_object)
+    {
+      --s_nLiveReferences;
+    }
+    return std::exchange(m_object, nullptr);
+  }
+
+  PyObject* Get() const { return m_object; }
+  operator PyObject*() const { return m_object; }
+
+  /// Number of live references owned by PythonReference instances.
+  static int GetNumberOfLiveReferences() { return s_nLiveReferences; }
+
+private:
+  void Track()
+  {
+    if (m_object)
+    {
+      ++s_nLiveReferences;
+    }
+  }
+
+  PyObject* m_object{ nullptr };
+  static inline std::atomic<int> s_nLiveReferences{ 0 };
+};
+} // namespace layer_dm
+
+#endif
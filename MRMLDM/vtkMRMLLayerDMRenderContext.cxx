@@ -0,0 +1,67 @@
+#include "vtkMRMLLayerDMRenderContext.h"
+
+#include <vtkCamera.h>
+#include <vtkObjectFactory.h>
+#include <vtkRenderWindow.h>
+
+vtkStandardNewMacro(vtkMRMLLayerDMRenderContext);
+
+vtkMRMLLayerDMRenderContext::vtkMRMLLayerDMRenderContext()
+  : m_camera{ nullptr }
+  , m_frameIndex{ 0 }
+  , m_cameraChanges{ 0 }
+  , m_viewSize{}
+  , m_isViewSizeChanged{ false }
+{
+}
+
+void vtkMRMLLayerDMRenderContext::Update(vtkRenderWindow* renderWindow, vtkCamera* camera, int cameraChanges)
+{
+  ++m_frameIndex;
+  m_camera = camera;
+  m_cameraChanges = cameraChanges;
+
+  std::array<int, 2> viewSize{};
+  if (renderWindow)
+  {
+    const int* size = renderWindow->GetSize();
+    viewSize = { size[0], size[1] };
+  }
+  m_isViewSizeChanged = (viewSize != m_viewSize);
+  m_viewSize = viewSize;
+}
+
+unsigned long vtkMRMLLayerDMRenderContext::GetFrameIndex() const
+{
+  return m_frameIndex;
+}
+
+vtkCamera* vtkMRMLLayerDMRenderContext::GetCamera() const
+{
+  return m_camera;
+}
+
+int vtkMRMLLayerDMRenderContext::GetCameraChanges() const
+{
+  return m_cameraChanges;
+}
+
+void vtkMRMLLayerDMRenderContext::GetViewSize(int size[2]) const
+{
+  size[0] = m_viewSize[0];
+  size[1] = m_viewSize[1];
+}
+
+bool vtkMRMLLayerDMRenderContext::IsViewSizeChanged() const
+{
+  return m_isViewSizeChanged;
+}
+
+bool vtkMRMLLayerDMRenderContext::IsViewChanged(int cameraChangeMask) const
+{
+  if (cameraChangeMask == 0)
+  {
+    return false;
+  }
+  return (m_cameraChanges & cameraChangeMask) || m_isViewSizeChanged;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
+
+#include <vtkObject.h>
+#include <vtkWeakPointer.h>
+
+#include <array>
+
+class vtkCamera;
+class vtkRenderWindow;
+
+/// \brief View state of the frame about to be rendered, passed to \sa vtkMRMLLayerDMPipelineI::OnBeforeRender.
+///
+/// The context is updated once per frame by \sa vtkMRMLLayerDMPipelineManager when the render of the view starts.
+/// It summarizes the view-dependent inputs changed since the previous frame so that pipelines maintaining view-dependent
+/// geometry (constant pixel size handles, billboards, labels) update once per frame instead of once per camera
+/// modification.
+class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMRenderContext : public vtkObject
+{
+public:
+  static vtkMRMLLayerDMRenderContext* New();
+  vtkTypeMacro(vtkMRMLLayerDMRenderContext, vtkObject);
+
+  /// Refresh the context for the frame starting on the input render window and increment the frame index.
+  /// \param cameraChanges: \sa vtkMRMLLayerDMPipelineI::CameraChange components modified since the previous frame.
+  void Update(vtkRenderWindow* renderWindow, vtkCamera* camera, int cameraChanges);
+
+  /// Index of the frame, incremented on each \sa Update.
+  unsigned long GetFrameIndex() const;
+
+  /// Returns the default camera of the view.
+  vtkCamera* GetCamera() const;
+
+  /// Bit mask of the \sa vtkMRMLLayerDMPipelineI::CameraChange components modified since the previous frame.
+  int GetCameraChanges() const;
+
+  /// Render window size in pixels.
+  void GetViewSize(int size[2]) const;
+
+  /// true if the render window size changed since the previous frame.
+  bool IsViewSizeChanged() const;
+
+  /// true if the camera components of the input mask or the view size changed since the previous frame.
+  /// The view size is ignored for empty masks.
+  bool IsViewChanged(int cameraChangeMask) const;
+
+protected:
+  vtkMRMLLayerDMRenderContext();
+  ~vtkMRMLLayerDMRenderContext() override = default;
+
+private:
+  vtkWeakPointer<vtkCamera> m_camera;
+  unsigned long m_frameIndex;
+  int m_cameraChanges;
+  std::array<int, 2> m_viewSize;
+  bool m_isViewSizeChanged;
+};
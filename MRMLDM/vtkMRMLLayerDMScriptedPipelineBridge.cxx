@@ -1,14 +1,91 @@
 #include "vtkMRMLLayerDMScriptedPipelineBridge.h"
 
 #include "vtkMRMLInteractionEventData.h"
+#include "vtkMRMLLayerDMRenderContext.h"
 
 #include <vtkObjectFactory.h>
-#include <vtkSmartPyObject.h>
 #include <vtkPythonUtil.h>
 #include <vtkCamera.h>
+#include <vtkDataArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationObjectBaseKey.h>
+#include <vtkPoints.h>
 #include <vtkRenderer.h>
 
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
 vtkStandardNewMacro(vtkMRMLLayerDMScriptedPipelineBridge);
+vtkInformationKeyMacro(vtkMRMLLayerDMScriptedPipelineBridge, PYTHON_BUFFER, ObjectBase);
+
+namespace
+{
+/// Keeps a python buffer alive while it is used as a VTK array storage.
+class vtkPythonBufferHolder : public vtkObject
+{
+public:
+  static vtkPythonBufferHolder* New();
+  vtkTypeMacro(vtkPythonBufferHolder, vtkObject);
+
+  Py_buffer Buffer{};
+
+protected:
+  vtkPythonBufferHolder() = default;
+  ~vtkPythonBufferHolder() override
+  {
+    if (Py_IsInitialized() && this->Buffer.obj)
+    {
+      vtkPythonScopeGilEnsurer gilEnsurer;
+      PyBuffer_Release(&this->Buffer);
+    }
+  }
+};
+vtkStandardNewMacro(vtkPythonBufferHolder);
+
+/// true if the buffer struct format item matches the VTK data type. GIL is expected to be held.
+bool IsBufferFormatCompatible(const Py_buffer& buffer, int dataType, int dataTypeSize)
+{
+  if (buffer.itemsize != dataTypeSize)
+  {
+    return false;
+  }
+
+  // Skip native byte order / alignment prefixes
+  const char* format = buffer.format ? buffer.format : "B";
+  if (*format == '@' || *format == '=')
+  {
+    ++format;
+  }
+  if (std::strlen(format) != 1)
+  {
+    return false;
+  }
+
+  const std::string floatingFormats = "efd";
+  const std::string signedFormats = "bhilqn";
+  const std::string unsignedFormats = "BHILQN?";
+  switch (dataType)
+  {
+    case VTK_FLOAT:
+    case VTK_DOUBLE: return floatingFormats.find(*format) != std::string::npos;
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_INT:
+    case VTK_LONG:
+    case VTK_LONG_LONG:
+    case VTK_ID_TYPE: return signedFormats.find(*format) != std::string::npos;
+    case VTK_UNSIGNED_CHAR:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_UNSIGNED_INT:
+    case VTK_UNSIGNED_LONG:
+    case VTK_UNSIGNED_LONG_LONG: return unsignedFormats.find(*format) != std::string::npos;
+    default: return false;
+  }
+}
+} // namespace
 
 inline PyObject* ToPyObject(vtkObjectBase* obj)
 {
@@ -20,6 +97,14 @@ inline PyObject* ToPyObject(unsigned long value)
   return PyLong_FromUnsignedLong(value);
 }
 
+inline PyObject* ToPyObject(PyObject* obj)
+{
+  // Return new reference, None if obj is nullptr
+  PyObject* pyObj = obj ? obj : Py_None;
+  Py_INCREF(pyObj);
+  return pyObj;
+}
+
 inline PyObject* ToPyObject(void* ptr)
 {
   if (ptr)
@@ -32,8 +117,29 @@ inline PyObject* ToPyObject(void* ptr)
   return Py_None;
 }
 
+class vtkMRMLLayerDMScriptedPipelineBridge::PythonMethodScope
+{
+public:
+  PythonMethodScope(const vtkMRMLLayerDMScriptedPipelineBridge* bridge, PythonMethod method)
+    : m_start{ bridge->m_isProfiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{} }
+    , m_gilEnsurer{}
+  {
+    if (bridge->m_isProfiling)
+    {
+      auto& counters = bridge->m_profilingCounters[static_cast<size_t>(method)];
+      counters.GilAcquisitionCount++;
+      counters.GilWaitTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+  }
+
+private:
+  // Declared before the GIL ensurer to be initialized before the GIL acquisition
+  std::chrono::steady_clock::time_point m_start;
+  vtkPythonScopeGilEnsurer m_gilEnsurer;
+};
+
 template <typename... Args>
-vtkSmartPyObject ToPyArgs(Args... args)
+layer_dm::PythonReference ToPyArgs(Args... args)
 {
   // Convert each argument to PyObject*
   PyObject* pyObjs[] = { ToPyObject(args)... };
@@ -45,22 +151,80 @@ vtkSmartPyObject ToPyArgs(Args... args)
     PyTuple_SET_ITEM(pyTuple, i, pyObjs[i]);
   }
 
-  return { pyTuple };
+  return layer_dm::PythonReference(pyTuple);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::UpdatePipeline()
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::UpdatePipeline))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod({}, __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::UpdatePipeline);
+  CallPythonMethod(nullptr, PythonMethod::UpdatePipeline);
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::IsUpdateAsync() const
+{
+  return IsPythonMethodOverridden(PythonMethod::ComputeUpdateAsync);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ComputeUpdateAsync()
+{
+  if (!IsPythonMethodOverridden(PythonMethod::ComputeUpdateAsync))
+  {
+    return;
+  }
+
+  // Called on a worker thread, the GIL is acquired by the scope
+  PythonMethodScope pythonScope(this, PythonMethod::ComputeUpdateAsync);
+  m_asyncUpdateResult = CallPythonMethod(nullptr, PythonMethod::ComputeUpdateAsync);
+  if (!m_asyncUpdateResult)
+  {
+    // The python exception is printed by CallPythonMethod, the pipeline manager reports the update as failed
+    throw std::runtime_error("Python ComputeUpdateAsync raised an exception.");
+  }
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ApplyUpdate()
+{
+  if (!IsPythonMethodOverridden(PythonMethod::ApplyUpdate))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::ApplyUpdate);
+  CallPythonMethod(ToPyArgs(m_asyncUpdateResult.Get()), PythonMethod::ApplyUpdate);
+  m_asyncUpdateResult.Reset();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::WaitForAsyncUpdate(const std::future<void>& future) const
+{
+  // The worker needs the GIL to complete, release it if held by the waiting thread
+  if (Py_IsInitialized() && PyGILState_Check())
+  {
+    Py_BEGIN_ALLOW_THREADS
+    future.wait();
+    Py_END_ALLOW_THREADS
+  }
+  else
+  {
+    future.wait();
+  }
 }
 
 vtkMRMLLayerDMScriptedPipelineBridge::vtkMRMLLayerDMScriptedPipelineBridge()
-  : m_object{ nullptr }
+  : m_object{}
+  , m_hasStaticRenderLayer{ false }
+  , m_staticRenderLayer{ 0 }
+  , m_hasStaticCamera{ false }
+  , m_staticCamera{ nullptr }
+  , m_methods{}
+  , m_isMethodOverridden{}
+  , m_isOnUpdateCallDataEnabled{ true }
+  , m_isProfiling{ false }
+  , m_profilingCounters{}
 {
 }
 
@@ -69,43 +233,113 @@ vtkMRMLLayerDMScriptedPipelineBridge::~vtkMRMLLayerDMScriptedPipelineBridge()
   if (Py_IsInitialized())
   {
     vtkPythonScopeGilEnsurer gilEnsurer;
-    Py_XDECREF(m_object);
+    for (auto& pyMethod : m_methods)
+    {
+      pyMethod.Reset();
+    }
+    m_onUpdateArgs.Reset();
+    m_onUpdateEventIds.clear();
+    m_asyncUpdateResult.Reset();
+    m_object.Reset();
   }
 }
 
 bool vtkMRMLLayerDMScriptedPipelineBridge::CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::CanProcessInteractionEvent))
   {
     return false;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  if (auto result = CallPythonMethod(ToPyArgs(eventData), __func__))
+  PythonMethodScope pythonScope(this, PythonMethod::CanProcessInteractionEvent);
+  auto result = CallPythonMethod(ToPyArgs(eventData), PythonMethod::CanProcessInteractionEvent);
+  return ParseCanProcessResult(result, distance2);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::CanProcessInteractionEventBatch(const std::vector<vtkMRMLLayerDMPipelineI*>& pipelines,
+                                                                           vtkMRMLInteractionEventData* eventData,
+                                                                           std::vector<CanProcessResult>& results)
+{
+  results.assign(pipelines.size(), std::make_tuple(false, std::numeric_limits<double>::max(), 0, 0u));
+  if (!Py_IsInitialized())
   {
-    int canProcess;
-    if (PyTuple_Check(result) && PyArg_ParseTuple(result, "pd", &canProcess, &distance2))
+    return;
+  }
+
+  // Acquire the GIL and wrap the event data once for all the batched pipelines
+  PythonMethodScope pythonScope(this, PythonMethod::CanProcessInteractionEvent);
+  auto pyArgs = ToPyArgs(eventData);
+  for (size_t iPipeline = 0; iPipeline < pipelines.size(); ++iPipeline)
+  {
+    auto& [canProcess, distance2, widgetState, renderLayer] = results[iPipeline];
+    auto pipeline = pipelines[iPipeline];
+    auto bridge = vtkMRMLLayerDMScriptedPipelineBridge::SafeDownCast(pipeline);
+    if (!bridge)
     {
-      return canProcess;
+      canProcess = pipeline->CanProcessInteractionEvent(eventData, distance2);
+      if (canProcess)
+      {
+        widgetState = pipeline->GetWidgetState();
+        renderLayer = pipeline->GetRenderLayer();
+      }
+      continue;
     }
 
-    // Unpack error or unexpected return type
-    PyErr_SetString(PyExc_TypeError, "Expected a tuple[bool, float] return type");
-    PyErr_Print();
+    if (!bridge->IsPythonMethodOverridden(PythonMethod::CanProcessInteractionEvent))
+    {
+      continue;
+    }
+
+    auto result = bridge->CallPythonMethod(pyArgs, PythonMethod::CanProcessInteractionEvent);
+    canProcess = ParseCanProcessResult(result, distance2);
+    if (canProcess)
+    {
+      widgetState = bridge->GetPythonWidgetState();
+      renderLayer = bridge->GetPythonRenderLayer();
+    }
+  }
+}
+
+const void* vtkMRMLLayerDMScriptedPipelineBridge::GetCanProcessBatchKey() const
+{
+  // All the scripted pipelines calling python share the same batch
+  static const char batchKey{};
+  return IsPythonMethodOverridden(PythonMethod::CanProcessInteractionEvent) ? &batchKey : nullptr;
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::ParseCanProcessResult(PyObject* result, double& distance2)
+{
+  if (!result)
+  {
+    return false;
+  }
+
+  int canProcess;
+  if (PyTuple_Check(result) && PyArg_ParseTuple(result, "pd", &canProcess, &distance2))
+  {
+    return canProcess;
   }
 
+  // Unpack error or unexpected return type
+  PyErr_SetString(PyExc_TypeError, "Expected a tuple[bool, float] return type");
+  PyErr_Print();
   return false;
 }
 
 vtkCamera* vtkMRMLLayerDMScriptedPipelineBridge::GetCamera() const
 {
-  if (!Py_IsInitialized())
+  if (m_hasStaticCamera)
+  {
+    return m_staticCamera;
+  }
+
+  if (!IsPythonMethodOverridden(PythonMethod::GetCamera))
   {
     return Superclass::GetCamera();
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  auto result = CallPythonMethod({}, __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::GetCamera);
+  auto result = CallPythonMethod(nullptr, PythonMethod::GetCamera);
   if (result && (result != Py_None))
   {
     return vtkCamera::SafeDownCast(vtkPythonUtil::GetPointerFromObject(result, "vtkCamera"));
@@ -115,13 +349,13 @@ vtkCamera* vtkMRMLLayerDMScriptedPipelineBridge::GetCamera() const
 
 int vtkMRMLLayerDMScriptedPipelineBridge::GetMouseCursor() const
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::GetMouseCursor))
   {
     return Superclass::GetMouseCursor();
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  if (auto result = CallPythonMethod({}, __func__))
+  PythonMethodScope pythonScope(this, PythonMethod::GetMouseCursor);
+  if (auto result = CallPythonMethod(nullptr, PythonMethod::GetMouseCursor))
   {
     return PyLong_AsLong(result);
   }
@@ -130,13 +364,28 @@ int vtkMRMLLayerDMScriptedPipelineBridge::GetMouseCursor() const
 
 unsigned int vtkMRMLLayerDMScriptedPipelineBridge::GetRenderLayer() const
 {
-  if (!Py_IsInitialized())
+  if (m_hasStaticRenderLayer || !IsPythonMethodOverridden(PythonMethod::GetRenderLayer))
+  {
+    return GetPythonRenderLayer();
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::GetRenderLayer);
+  return GetPythonRenderLayer();
+}
+
+unsigned int vtkMRMLLayerDMScriptedPipelineBridge::GetPythonRenderLayer() const
+{
+  if (m_hasStaticRenderLayer)
+  {
+    return m_staticRenderLayer;
+  }
+
+  if (!IsPythonMethodOverridden(PythonMethod::GetRenderLayer))
   {
     return Superclass::GetRenderLayer();
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  if (auto result = CallPythonMethod({}, __func__))
+  if (auto result = CallPythonMethod(nullptr, PythonMethod::GetRenderLayer))
   {
     return PyLong_AsLong(result);
   }
@@ -145,72 +394,112 @@ unsigned int vtkMRMLLayerDMScriptedPipelineBridge::GetRenderLayer() const
 
 int vtkMRMLLayerDMScriptedPipelineBridge::GetWidgetState() const
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::GetWidgetState))
   {
     return Superclass::GetWidgetState();
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  if (auto result = CallPythonMethod({}, __func__))
+  PythonMethodScope pythonScope(this, PythonMethod::GetWidgetState);
+  return GetPythonWidgetState();
+}
+
+int vtkMRMLLayerDMScriptedPipelineBridge::GetPythonWidgetState() const
+{
+  if (!IsPythonMethodOverridden(PythonMethod::GetWidgetState))
+  {
+    return Superclass::GetWidgetState();
+  }
+
+  if (auto result = CallPythonMethod(nullptr, PythonMethod::GetWidgetState))
   {
     return PyLong_AsLong(result);
   }
   return Superclass::GetWidgetState();
 }
 
+bool vtkMRMLLayerDMScriptedPipelineBridge::IsCanProcessInteractionEventThreadSafe() const
+{
+  // Python calls require the GIL and are always evaluated on the main thread
+  return false;
+}
+
 void vtkMRMLLayerDMScriptedPipelineBridge::LoseFocus(vtkMRMLInteractionEventData* eventData)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::LoseFocus))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(eventData), __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::LoseFocus);
+  CallPythonMethod(ToPyArgs(eventData), PythonMethod::LoseFocus);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::OnBeforeRender(vtkMRMLLayerDMRenderContext* context)
+{
+  if (!IsPythonMethodOverridden(PythonMethod::OnBeforeRender))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::OnBeforeRender);
+  CallPythonMethod(ToPyArgs(context), PythonMethod::OnBeforeRender);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::OnDefaultCameraChanged(vtkCamera* camera, int cameraChanges)
+{
+  if (!IsPythonMethodOverridden(PythonMethod::OnDefaultCameraChanged))
+  {
+    // Pipelines only implementing the one-argument hook keep being notified
+    OnDefaultCameraModified(camera);
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::OnDefaultCameraChanged);
+  CallPythonMethod(ToPyArgs(camera, static_cast<unsigned long>(cameraChanges)), PythonMethod::OnDefaultCameraChanged);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::OnDefaultCameraModified(vtkCamera* camera)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::OnDefaultCameraModified))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(camera), __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::OnDefaultCameraModified);
+  CallPythonMethod(ToPyArgs(camera), PythonMethod::OnDefaultCameraModified);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::OnRendererAdded(vtkRenderer* renderer)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::OnRendererAdded))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(renderer), __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::OnRendererAdded);
+  CallPythonMethod(ToPyArgs(renderer), PythonMethod::OnRendererAdded);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::OnRendererRemoved(vtkRenderer* renderer)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::OnRendererRemoved))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(renderer), __func__);
+  PythonMethodScope pythonScope(this, PythonMethod::OnRendererRemoved);
+  CallPythonMethod(ToPyArgs(renderer), PythonMethod::OnRendererRemoved);
 }
 
 bool vtkMRMLLayerDMScriptedPipelineBridge::ProcessInteractionEvent(vtkMRMLInteractionEventData* eventData)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::ProcessInteractionEvent))
   {
     return false;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  if (auto result = CallPythonMethod(ToPyArgs(eventData), __func__))
+  PythonMethodScope pythonScope(this, PythonMethod::ProcessInteractionEvent);
+  if (auto result = CallPythonMethod(ToPyArgs(eventData), PythonMethod::ProcessInteractionEvent))
   {
     return result == Py_True;
   }
@@ -225,8 +514,13 @@ void vtkMRMLLayerDMScriptedPipelineBridge::SetDisplayNode(vtkMRMLNode* displayNo
   }
 
   Superclass::SetDisplayNode(displayNode);
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(displayNode), __func__);
+  if (!IsPythonMethodOverridden(PythonMethod::SetDisplayNode))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::SetDisplayNode);
+  CallPythonMethod(ToPyArgs(displayNode), PythonMethod::SetDisplayNode);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::SetViewNode(vtkMRMLAbstractViewNode* viewNode)
@@ -237,8 +531,13 @@ void vtkMRMLLayerDMScriptedPipelineBridge::SetViewNode(vtkMRMLAbstractViewNode*
   }
 
   Superclass::SetViewNode(viewNode);
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(viewNode), __func__);
+  if (!IsPythonMethodOverridden(PythonMethod::SetViewNode))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::SetViewNode);
+  CallPythonMethod(ToPyArgs(viewNode), PythonMethod::SetViewNode);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::SetScene(vtkMRMLScene* scene)
@@ -249,8 +548,13 @@ void vtkMRMLLayerDMScriptedPipelineBridge::SetScene(vtkMRMLScene* scene)
   }
 
   Superclass::SetScene(scene);
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(scene), __func__);
+  if (!IsPythonMethodOverridden(PythonMethod::SetScene))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::SetScene);
+  CallPythonMethod(ToPyArgs(scene), PythonMethod::SetScene);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::SetPipelineManager(vtkMRMLLayerDMPipelineManager* pipelineManager)
@@ -261,8 +565,13 @@ void vtkMRMLLayerDMScriptedPipelineBridge::SetPipelineManager(vtkMRMLLayerDMPipe
   }
 
   Superclass::SetPipelineManager(pipelineManager);
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(pipelineManager), __func__);
+  if (!IsPythonMethodOverridden(PythonMethod::SetPipelineManager))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::SetPipelineManager);
+  CallPythonMethod(ToPyArgs(pipelineManager), PythonMethod::SetPipelineManager);
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::SetPythonObject(PyObject* object)
@@ -279,42 +588,396 @@ void vtkMRMLLayerDMScriptedPipelineBridge::SetPythonObject(PyObject* object)
   }
 
   // Set the new python lambda
-  Py_XDECREF(m_object);
-  m_object = object;
-  Py_INCREF(m_object);
+  m_object = layer_dm::PythonReference::FromBorrowed(object);
+  UpdatePythonMethodCache();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::SetStaticRenderLayer(unsigned int renderLayer)
+{
+  if (m_hasStaticRenderLayer && (m_staticRenderLayer == renderLayer))
+  {
+    return;
+  }
+
+  m_hasStaticRenderLayer = true;
+  m_staticRenderLayer = renderLayer;
+  RequestLayerUpdate();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ClearStaticRenderLayer()
+{
+  if (!m_hasStaticRenderLayer)
+  {
+    return;
+  }
+
+  m_hasStaticRenderLayer = false;
+  RequestLayerUpdate();
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::HasStaticRenderLayer() const
+{
+  return m_hasStaticRenderLayer;
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::SetStaticCamera(vtkCamera* camera)
+{
+  if (m_hasStaticCamera && (m_staticCamera == camera))
+  {
+    return;
+  }
+
+  m_hasStaticCamera = true;
+  m_staticCamera = camera;
+  RequestLayerUpdate();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ClearStaticCamera()
+{
+  if (!m_hasStaticCamera)
+  {
+    return;
+  }
+
+  m_hasStaticCamera = false;
+  m_staticCamera = nullptr;
+  RequestLayerUpdate();
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::HasStaticCamera() const
+{
+  return m_hasStaticCamera;
 }
 
 void vtkMRMLLayerDMScriptedPipelineBridge::OnUpdate(vtkObject* obj, unsigned long eventId, void* callData)
 {
-  if (!Py_IsInitialized())
+  if (!IsPythonMethodOverridden(PythonMethod::OnUpdate))
   {
     return;
   }
 
-  vtkPythonScopeGilEnsurer gilEnsurer;
-  CallPythonMethod(ToPyArgs(obj, eventId, callData), __func__);
+  // Filter the events before acquiring the GIL
+  if (!m_onUpdateEvents.empty() && !m_onUpdateEvents.count(eventId))
+  {
+    return;
+  }
+
+  PythonMethodScope pythonScope(this, PythonMethod::OnUpdate);
+  CallPythonMethod(GetOnUpdateArgs(obj, eventId, callData), PythonMethod::OnUpdate);
+  ReleaseOnUpdateArgs();
+}
+
+PyObject* vtkMRMLLayerDMScriptedPipelineBridge::GetOnUpdateArgs(vtkObject* obj, unsigned long eventId, void* callData)
+{
+  // Tuples can only be modified while not referenced elsewhere (for instance stored by the python method)
+  if (!m_onUpdateArgs || Py_REFCNT(m_onUpdateArgs.Get()) != 1)
+  {
+    m_onUpdateArgs.Reset(PyTuple_New(3));
+    for (Py_ssize_t iItem = 0; iItem < 3; ++iItem)
+    {
+      Py_INCREF(Py_None);
+      PyTuple_SET_ITEM(m_onUpdateArgs.Get(), iItem, Py_None);
+    }
+  }
+
+  auto& pyEventId = m_onUpdateEventIds[eventId];
+  if (!pyEventId)
+  {
+    pyEventId.Reset(ToPyObject(eventId));
+  }
+
+  // PyTuple_SetItem steals the new item references and releases the previous items
+  PyObject* pyArgs = m_onUpdateArgs.Get();
+  PyTuple_SetItem(pyArgs, 0, ToPyObject(obj));
+  PyTuple_SetItem(pyArgs, 1, ToPyObject(pyEventId.Get()));
+  PyTuple_SetItem(pyArgs, 2, m_isOnUpdateCallDataEnabled ? ToPyObject(callData) : ToPyObject(static_cast<void*>(nullptr)));
+  return m_onUpdateArgs;
 }
 
-PyObject* vtkMRMLLayerDMScriptedPipelineBridge::CallPythonMethod(const vtkSmartPyObject& pyArgs, const std::string& fName) const
+void vtkMRMLLayerDMScriptedPipelineBridge::ReleaseOnUpdateArgs()
 {
-  if (!m_object)
+  // Don't keep the observed object alive through the reused arguments
+  if (!m_onUpdateArgs || Py_REFCNT(m_onUpdateArgs.Get()) != 1)
   {
-    vtkErrorMacro("" << __func__ << ": Python object is invalid.");
-    return nullptr;
+    m_onUpdateArgs.Reset();
+    return;
+  }
+
+  PyObject* pyArgs = m_onUpdateArgs.Get();
+  for (Py_ssize_t iItem : { 0, 2 })
+  {
+    Py_INCREF(Py_None);
+    PyTuple_SetItem(pyArgs, iItem, Py_None);
+  }
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::AddOnUpdateEvent(unsigned long eventId)
+{
+  m_onUpdateEvents.emplace(eventId);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::RemoveOnUpdateEvent(unsigned long eventId)
+{
+  m_onUpdateEvents.erase(eventId);
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ClearOnUpdateEvents()
+{
+  m_onUpdateEvents.clear();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::SetOnUpdateCallDataEnabled(bool isEnabled)
+{
+  m_isOnUpdateCallDataEnabled = isEnabled;
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::GetOnUpdateCallDataEnabled() const
+{
+  return m_isOnUpdateCallDataEnabled;
+}
+
+const char* vtkMRMLLayerDMScriptedPipelineBridge::GetPythonMethodName(PythonMethod method)
+{
+  switch (method)
+  {
+    case PythonMethod::ApplyUpdate: return "ApplyUpdate";
+    case PythonMethod::CanProcessInteractionEvent: return "CanProcessInteractionEvent";
+    case PythonMethod::ComputeUpdateAsync: return "ComputeUpdateAsync";
+    case PythonMethod::GetCamera: return "GetCamera";
+    case PythonMethod::GetMouseCursor: return "GetMouseCursor";
+    case PythonMethod::GetRenderLayer: return "GetRenderLayer";
+    case PythonMethod::GetWidgetState: return "GetWidgetState";
+    case PythonMethod::LoseFocus: return "LoseFocus";
+    case PythonMethod::OnBeforeRender: return "OnBeforeRender";
+    case PythonMethod::OnDefaultCameraChanged: return "OnDefaultCameraChanged";
+    case PythonMethod::OnDefaultCameraModified: return "OnDefaultCameraModified";
+    case PythonMethod::OnRendererAdded: return "OnRendererAdded";
+    case PythonMethod::OnRendererRemoved: return "OnRendererRemoved";
+    case PythonMethod::OnUpdate: return "OnUpdate";
+    case PythonMethod::ProcessInteractionEvent: return "ProcessInteractionEvent";
+    case PythonMethod::SetDisplayNode: return "SetDisplayNode";
+    case PythonMethod::SetPipelineManager: return "SetPipelineManager";
+    case PythonMethod::SetScene: return "SetScene";
+    case PythonMethod::SetViewNode: return "SetViewNode";
+    case PythonMethod::UpdatePipeline: return "UpdatePipeline";
+    default: return "";
   }
+}
 
-  PyObject* method = PyObject_GetAttrString(m_object, fName.c_str());
-  if (!method || !PyCallable_Check(method))
+layer_dm::PythonReference vtkMRMLLayerDMScriptedPipelineBridge::CallPythonMethod(PyObject* pyArgs, PythonMethod method) const
+{
+  const auto& pyMethod = m_methods[static_cast<size_t>(method)];
+  if (!pyMethod)
   {
-    vtkErrorMacro("" << __func__ << ": Invalid method : " << fName);
-    return nullptr;
+    vtkErrorMacro("" << __func__ << ": Invalid method : " << GetPythonMethodName(method));
+    return {};
+  }
+
+  auto start = m_isProfiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+  layer_dm::PythonReference result(PyObject_CallObject(pyMethod, pyArgs));
+  if (m_isProfiling)
+  {
+    double callTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    auto& counters = m_profilingCounters[static_cast<size_t>(method)];
+    counters.CallCount++;
+    counters.TotalTime += callTime;
+    counters.MaxTime = std::max(counters.MaxTime, callTime);
   }
 
-  PyObject* result = PyObject_CallObject(method, pyArgs);
   if (!result)
   {
     PyErr_Print();
-    return nullptr;
   }
   return result;
 }
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::IsPythonMethodOverridden(PythonMethod method) const
+{
+  return Py_IsInitialized() && m_object && m_isMethodOverridden[static_cast<size_t>(method)];
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::UpdatePythonMethodCache()
+{
+  for (size_t iMethod = 0; iMethod < m_methods.size(); ++iMethod)
+  {
+    auto& pyMethod = m_methods[iMethod];
+    pyMethod.Reset(m_object ? PyObject_GetAttrString(m_object, GetPythonMethodName(static_cast<PythonMethod>(iMethod))) : nullptr);
+    if (!pyMethod || !PyCallable_Check(pyMethod))
+    {
+      PyErr_Clear();
+      pyMethod.Reset();
+      m_isMethodOverridden[iMethod] = false;
+      continue;
+    }
+
+    // Default implementations of vtkMRMLLayerDMScriptedPipeline are flagged with _layerDMDefault = True.
+    // The flag is compared to True as mock objects return a truthy value for any attribute name.
+    layer_dm::PythonReference isDefault(PyObject_GetAttrString(pyMethod, "_layerDMDefault"));
+    PyErr_Clear();
+    m_isMethodOverridden[iMethod] = (isDefault.Get() != Py_True);
+  }
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::SetArrayFromPythonBuffer(vtkDataArray* array, PyObject* buffer, int numberOfComponents)
+{
+  if (!array || !buffer || !Py_IsInitialized())
+  {
+    return false;
+  }
+
+  vtkPythonScopeGilEnsurer gilEnsurer;
+  auto holder = vtkSmartPointer<vtkPythonBufferHolder>::New();
+  if (PyObject_GetBuffer(buffer, &holder->Buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+  {
+    PyErr_Clear();
+    vtkGenericWarningMacro("" << __func__ << ": Input object is not a writable C-contiguous buffer.");
+    return false;
+  }
+
+  const auto& pyBuffer = holder->Buffer;
+  if (!IsBufferFormatCompatible(pyBuffer, array->GetDataType(), array->GetDataTypeSize()))
+  {
+    vtkGenericWarningMacro("" << __func__ << ": Buffer item type " << (pyBuffer.format ? pyBuffer.format : "") << " doesn't match the array data type "
+                              << array->GetDataTypeAsString() << ".");
+    return false;
+  }
+
+  if (numberOfComponents <= 0)
+  {
+    numberOfComponents = (pyBuffer.ndim == 2) ? static_cast<int>(pyBuffer.shape[1]) : array->GetNumberOfComponents();
+  }
+
+  vtkIdType nValues = static_cast<vtkIdType>(pyBuffer.len / pyBuffer.itemsize);
+  if (numberOfComponents <= 0 || (nValues % numberOfComponents) != 0)
+  {
+    vtkGenericWarningMacro("" << __func__ << ": Buffer size " << nValues << " is not a multiple of the number of components " << numberOfComponents << ".");
+    return false;
+  }
+
+  // The buffer memory is owned by python (save = 1) and released with the holder when the array is deleted
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetVoidArray(pyBuffer.buf, nValues, 1);
+  array->GetInformation()->Set(PYTHON_BUFFER(), holder);
+  array->Modified();
+  return true;
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::SetPointsFromPythonBuffer(vtkPoints* points, PyObject* buffer)
+{
+  if (!points || !buffer || !Py_IsInitialized())
+  {
+    return false;
+  }
+
+  // Match the points data type with the buffer item type
+  {
+    vtkPythonScopeGilEnsurer gilEnsurer;
+    Py_buffer view;
+    if (PyObject_GetBuffer(buffer, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+    {
+      PyErr_Clear();
+      vtkGenericWarningMacro("" << __func__ << ": Input object is not a writable C-contiguous buffer.");
+      return false;
+    }
+
+    int dataType = (view.itemsize == sizeof(double)) ? VTK_DOUBLE : VTK_FLOAT;
+    PyBuffer_Release(&view);
+    if (points->GetDataType() != dataType)
+    {
+      points->SetDataType(dataType);
+    }
+  }
+
+  if (!SetArrayFromPythonBuffer(points->GetData(), buffer, 3))
+  {
+    return false;
+  }
+  points->Modified();
+  return true;
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::SetProfilingEnabled(bool isEnabled)
+{
+  m_isProfiling = isEnabled;
+}
+
+bool vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingEnabled() const
+{
+  return m_isProfiling;
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::ResetProfilingCounters()
+{
+  m_profilingCounters.fill({});
+}
+
+std::vector<std::string> vtkMRMLLayerDMScriptedPipelineBridge::GetProfiledMethodNames() const
+{
+  std::vector<std::string> names;
+  for (size_t iMethod = 0; iMethod < m_profilingCounters.size(); ++iMethod)
+  {
+    if (m_profilingCounters[iMethod].CallCount > 0)
+    {
+      names.emplace_back(GetPythonMethodName(static_cast<PythonMethod>(iMethod)));
+    }
+  }
+  return names;
+}
+
+int vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingCallCount(const std::string& methodName) const
+{
+  auto counters = GetProfilingCounters(methodName);
+  return counters ? counters->CallCount : 0;
+}
+
+double vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingTotalTime(const std::string& methodName) const
+{
+  auto counters = GetProfilingCounters(methodName);
+  return counters ? counters->TotalTime : 0;
+}
+
+double vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingMaxTime(const std::string& methodName) const
+{
+  auto counters = GetProfilingCounters(methodName);
+  return counters ? counters->MaxTime : 0;
+}
+
+int vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingGilAcquisitionCount(const std::string& methodName) const
+{
+  auto counters = GetProfilingCounters(methodName);
+  return counters ? counters->GilAcquisitionCount : 0;
+}
+
+double vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingGilWaitTime(const std::string& methodName) const
+{
+  auto counters = GetProfilingCounters(methodName);
+  return counters ? counters->GilWaitTime : 0;
+}
+
+const vtkMRMLLayerDMScriptedPipelineBridge::ProfilingCounters* vtkMRMLLayerDMScriptedPipelineBridge::GetProfilingCounters(const std::string& methodName) const
+{
+  for (size_t iMethod = 0; iMethod < m_profilingCounters.size(); ++iMethod)
+  {
+    if (methodName == GetPythonMethodName(static_cast<PythonMethod>(iMethod)))
+    {
+      return &m_profilingCounters[iMethod];
+    }
+  }
+  return nullptr;
+}
+
+int vtkMRMLLayerDMScriptedPipelineBridge::GetNumberOfLivePythonReferences()
+{
+  return layer_dm::PythonReference::GetNumberOfLiveReferences();
+}
+
+void vtkMRMLLayerDMScriptedPipelineBridge::InvalidatePythonMethodCache()
+{
+  if (!Py_IsInitialized())
+  {
+    return;
+  }
+
+  vtkPythonScopeGilEnsurer gilEnsurer;
+  UpdatePythonMethodCache();
+}
@@ -3,14 +3,46 @@
 #include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
 
 #include "vtkMRMLLayerDMPipelineI.h"
+#include "vtkMRMLLayerDMPythonReference.h"
 
 #include <vtkPython.h>
 
-class vtkSmartPyObject;
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+class vtkDataArray;
+class vtkInformationObjectBaseKey;
+class vtkPoints;
 
 /// \brief Python bridge for vtkMRMLLayerDMPipelineI.
 /// Delegates calls to the pipeline to its underlying python object.
 ///
+/// The python object methods are resolved once in \sa SetPythonObject.
+/// Methods inherited unchanged from vtkMRMLLayerDMScriptedPipeline (marked as default implementations) are not called
+/// and the C++ default implementation is used instead, without acquiring the GIL.
+/// If the python object methods are modified after \sa SetPythonObject, \sa InvalidatePythonMethodCache should be called.
+///
+/// Scripted pipelines overriding CanProcessInteractionEvent share the same batch key. During interaction, they are
+/// evaluated in a single GIL section with the event data wrapped once for all the pipelines. The widget state and
+/// render layer of the pipelines which can process the event are queried in the same GIL section.
+///
+/// Observed events forwarded to the python OnUpdate can be filtered in C++ using \sa AddOnUpdateEvent, and the
+/// callData wrapping can be disabled using \sa SetOnUpdateCallDataEnabled for high frequency events.
+///
+/// Python references created by the bridge are owned by RAII holders and released under the GIL. The number of live
+/// references can be monitored using \sa GetNumberOfLivePythonReferences to detect leaks.
+///
+/// Python calls can be profiled per method using \sa SetProfilingEnabled to identify the slow scripted pipelines.
+///
+/// Contiguous python buffers (for instance NumPy arrays) can be used as VTK array storage without copy using
+/// \sa SetArrayFromPythonBuffer and \sa SetPointsFromPythonBuffer.
+///
+/// Pipelines with a fixed render layer or camera can declare them using \sa SetStaticRenderLayer and
+/// \sa SetStaticCamera. Declared values are returned by \sa GetRenderLayer and \sa GetCamera without calling python.
+///
 /// \sa vtkMRMLLayerDMPipelineI
 /// \sa vtkMRMLLayerDMScriptedPipeline
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkMRMLLayerDMScriptedPipelineBridge : public vtkMRMLLayerDMPipelineI
@@ -20,11 +52,18 @@ public:
   vtkTypeMacro(vtkMRMLLayerDMScriptedPipelineBridge, vtkMRMLLayerDMPipelineI);
 
   bool CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2) override;
+  void CanProcessInteractionEventBatch(const std::vector<vtkMRMLLayerDMPipelineI*>& pipelines,
+                                       vtkMRMLInteractionEventData* eventData,
+                                       std::vector<CanProcessResult>& results) override;
+  const void* GetCanProcessBatchKey() const override;
   vtkCamera* GetCamera() const override;
   int GetMouseCursor() const override;
   unsigned int GetRenderLayer() const override;
   int GetWidgetState() const override;
+  bool IsCanProcessInteractionEventThreadSafe() const override;
   void LoseFocus(vtkMRMLInteractionEventData* eventData) override;
+  void OnBeforeRender(vtkMRMLLayerDMRenderContext* context) override;
+  void OnDefaultCameraChanged(vtkCamera* camera, int cameraChanges) override;
   void OnDefaultCameraModified(vtkCamera* camera) override;
   void OnRendererAdded(vtkRenderer* renderer) override;
   void OnRendererRemoved(vtkRenderer* renderer) override;
@@ -36,6 +75,104 @@ public:
   void SetPythonObject(PyObject* object);
   void UpdatePipeline() override;
 
+  /// @{
+  /// Asynchronous update of the python pipeline.
+  /// The pipeline update is asynchronous if the python ComputeUpdateAsync method is overridden.
+  /// ComputeUpdateAsync is called on a worker thread with the GIL held and its return value is forwarded to the python
+  /// ApplyUpdate method on the main thread. If ComputeUpdateAsync raises, the update fails and ApplyUpdate is not called.
+  /// The GIL is released while the main thread waits for the worker.
+  bool IsUpdateAsync() const override;
+  void ComputeUpdateAsync() override;
+  void ApplyUpdate() override;
+  void WaitForAsyncUpdate(const std::future<void>& future) const override;
+  /// @}
+
+  /// Resolve the python object methods again.
+  /// Should be called if the python object's methods are modified (monkey patched) after \sa SetPythonObject.
+  void InvalidatePythonMethodCache();
+
+  /// @{
+  /// Declare the render layer returned by \sa GetRenderLayer without calling the python object.
+  /// Changing the value after initialization moves the pipeline to its new layer.
+  /// \sa ClearStaticRenderLayer restores the python GetRenderLayer delegation.
+  void SetStaticRenderLayer(unsigned int renderLayer);
+  void ClearStaticRenderLayer();
+  bool HasStaticRenderLayer() const;
+  /// @}
+
+  /// @{
+  /// Declare the camera returned by \sa GetCamera without calling the python object.
+  /// nullptr declares that the pipeline uses the view's default camera.
+  /// Changing the value after initialization moves the pipeline to its new layer.
+  /// \sa ClearStaticCamera restores the python GetCamera delegation.
+  void SetStaticCamera(vtkCamera* camera);
+  void ClearStaticCamera();
+  bool HasStaticCamera() const;
+  /// @}
+
+  /// @{
+  /// Events forwarded to the python OnUpdate method.
+  /// If no event is declared (default), all the observed events are forwarded.
+  /// Events not declared are filtered out without entering python.
+  void AddOnUpdateEvent(unsigned long eventId);
+  void RemoveOnUpdateEvent(unsigned long eventId);
+  void ClearOnUpdateEvents();
+  /// @}
+
+  /// @{
+  /// If false, the python OnUpdate method receives None as callData instead of a capsule wrapping the pointer.
+  /// Default = true.
+  void SetOnUpdateCallDataEnabled(bool isEnabled);
+  bool GetOnUpdateCallDataEnabled() const;
+  /// @}
+
+  /// @{
+  /// Enable the per method profiling of the python calls. Disabled by default.
+  /// When enabled, the call count, cumulative and max call time, number of GIL acquisitions and time spent waiting for
+  /// the GIL are accumulated for each called python method. Calls batched in the GIL section of another method don't
+  /// count as GIL acquisitions.
+  void SetProfilingEnabled(bool isEnabled);
+  bool GetProfilingEnabled() const;
+  /// @}
+
+  /// Use the input contiguous python buffer as the array storage without copying it.
+  /// The buffer is kept alive until the array is deleted or its storage is set to another buffer.
+  /// The array is marked as modified so that only the arrays using new buffers are uploaded again by the mappers.
+  /// \param buffer: Writable C-contiguous object supporting the buffer protocol (for instance a NumPy array) with an
+  ///   item type matching the array data type. Read-only buffers are rejected as VTK arrays are always writable.
+  /// \param numberOfComponents: Number of components of the array. If <= 0, uses the second dimension of 2D buffers
+  ///   and the current array number of components otherwise.
+  /// \return false if the buffer is not writable and contiguous or doesn't match the array data type.
+  static bool SetArrayFromPythonBuffer(vtkDataArray* array, PyObject* buffer, int numberOfComponents = -1);
+
+  /// Use the input contiguous (N, 3) float32 or float64 python buffer as the points storage without copying it.
+  /// The points data type is changed to match the buffer type if needed.
+  /// \sa SetArrayFromPythonBuffer
+  static bool SetPointsFromPythonBuffer(vtkPoints* points, PyObject* buffer);
+
+  /// Information key holding the python buffer used as storage by an array.
+  static vtkInformationObjectBaseKey* PYTHON_BUFFER();
+
+  /// Reset the profiling counters of all the methods.
+  void ResetProfilingCounters();
+
+  /// Returns the names of the python methods called at least once since the last \sa ResetProfilingCounters.
+  std::vector<std::string> GetProfiledMethodNames() const;
+
+  /// @{
+  /// Profiling counters of the input python method name. Times are in ms.
+  /// 0 if the method name is invalid or the method was not called while profiling.
+  int GetProfilingCallCount(const std::string& methodName) const;
+  double GetProfilingTotalTime(const std::string& methodName) const;
+  double GetProfilingMaxTime(const std::string& methodName) const;
+  int GetProfilingGilAcquisitionCount(const std::string& methodName) const;
+  double GetProfilingGilWaitTime(const std::string& methodName) const;
+  /// @}
+
+  /// Number of python references currently owned by the scripted pipeline bridges and creators.
+  /// Debug counter: stays constant in steady state and returns to its initial value once the pipelines are deleted.
+  static int GetNumberOfLivePythonReferences();
+
 protected:
   vtkMRMLLayerDMScriptedPipelineBridge();
   ~vtkMRMLLayerDMScriptedPipelineBridge() override;
@@ -43,7 +180,85 @@ protected:
   void OnUpdate(vtkObject* obj, unsigned long eventId, void* callData) override;
 
 private:
-  PyObject* CallPythonMethod(const vtkSmartPyObject& pyArgs, const std::string& fName) const;
+  enum class PythonMethod
+  {
+    ApplyUpdate = 0,
+    CanProcessInteractionEvent,
+    ComputeUpdateAsync,
+    GetCamera,
+    GetMouseCursor,
+    GetRenderLayer,
+    GetWidgetState,
+    LoseFocus,
+    OnBeforeRender,
+    OnDefaultCameraChanged,
+    OnDefaultCameraModified,
+    OnRendererAdded,
+    OnRendererRemoved,
+    OnUpdate,
+    ProcessInteractionEvent,
+    SetDisplayNode,
+    SetPipelineManager,
+    SetScene,
+    SetViewNode,
+    UpdatePipeline,
+    Count
+  };
+
+  struct ProfilingCounters
+  {
+    int CallCount{ 0 };
+    double TotalTime{ 0 };
+    double MaxTime{ 0 };
+    int GilAcquisitionCount{ 0 };
+    double GilWaitTime{ 0 };
+  };
+
+  /// GIL section of a python method call. Measures the GIL wait time when profiling is enabled.
+  class PythonMethodScope;
+
+  static const char* GetPythonMethodName(PythonMethod method);
+  const ProfilingCounters* GetProfilingCounters(const std::string& methodName) const;
+
+  /// Unpack the python CanProcessInteractionEvent tuple[bool, float] result. GIL is expected to be held.
+  static bool ParseCanProcessResult(PyObject* result, double& distance2);
+
+  /// Call the cached python method with the input arguments tuple. GIL is expected to be held.
+  /// \return the owned call result, empty on python error.
+  layer_dm::PythonReference CallPythonMethod(PyObject* pyArgs, PythonMethod method) const;
+
+  /// true if the python method should be called (python is initialized and the method is overridden)
+  bool IsPythonMethodOverridden(PythonMethod method) const;
+
+  /// @{
+  /// Returns the python GetWidgetState / GetRenderLayer result, or the C++ value if not overridden.
+  /// GIL is expected to be held.
+  int GetPythonWidgetState() const;
+  unsigned int GetPythonRenderLayer() const;
+  /// @}
+
+  /// Resolve the bound methods of the python object and their override status. GIL is expected to be held.
+  void UpdatePythonMethodCache();
+
+  /// Returns the OnUpdate argument tuple filled with the input values. GIL is expected to be held.
+  /// The tuple is reused between calls if python doesn't hold any reference to it.
+  PyObject* GetOnUpdateArgs(vtkObject* obj, unsigned long eventId, void* callData);
+
+  /// Release the references held by the reused OnUpdate argument tuple. GIL is expected to be held.
+  void ReleaseOnUpdateArgs();
 
-  PyObject* m_object;
+  layer_dm::PythonReference m_object;
+  bool m_hasStaticRenderLayer;
+  unsigned int m_staticRenderLayer;
+  bool m_hasStaticCamera;
+  vtkSmartPointer<vtkCamera> m_staticCamera;
+  std::array<layer_dm::PythonReference, static_cast<size_t>(PythonMethod::Count)> m_methods;
+  std::array<bool, static_cast<size_t>(PythonMethod::Count)> m_isMethodOverridden;
+  std::set<unsigned long> m_onUpdateEvents;
+  bool m_isOnUpdateCallDataEnabled;
+  layer_dm::PythonReference m_onUpdateArgs;
+  std::map<unsigned long, layer_dm::PythonReference> m_onUpdateEventIds;
+  layer_dm::PythonReference m_asyncUpdateResult;
+  bool m_isProfiling;
+  mutable std::array<ProfilingCounters, static_cast<size_t>(PythonMethod::Count)> m_profilingCounters;
 };
\ No newline at end of file
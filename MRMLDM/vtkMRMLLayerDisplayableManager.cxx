@@ -65,6 +65,11 @@ bool vtkMRMLLayerDisplayableManager::IsRegisteredInFactory(vtkMRMLDisplayableMan
   return factory->IsDisplayableManagerRegistered(dm->GetClassName());
 }
 
+vtkMRMLLayerDMPipelineManager* vtkMRMLLayerDisplayableManager::GetPipelineManager() const
+{
+  return m_pipelineManager;
+}
+
 void vtkMRMLLayerDisplayableManager::OnMRMLSceneEndClose()
 {
   this->UpdateFromMRML();
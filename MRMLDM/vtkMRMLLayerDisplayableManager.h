@@ -32,6 +32,10 @@ public:
   /// true if the input factory is defined and displayable manager is present in the input factory
   static bool IsRegisteredInFactory(vtkMRMLDisplayableManagerFactory* factory);
 
+  /// Returns the internal pipeline manager.
+  /// nullptr before the displayable manager is created.
+  vtkMRMLLayerDMPipelineManager* GetPipelineManager() const;
+
 protected:
   vtkMRMLLayerDisplayableManager();
   ~vtkMRMLLayerDisplayableManager() override = default;
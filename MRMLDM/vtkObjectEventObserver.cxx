@@ -3,51 +3,23 @@
 #include <vtkCallbackCommand.h>
 #include <vtkObjectFactory.h>
 
-vtkStandardNewMacro(vtkObjectEventObserver);
-
-template <class... Ts>
-struct Overloaded : Ts...
-{
-  using Ts::operator()...;
-};
+#include <algorithm>
 
-template <class... Ts>
-Overloaded(Ts...) -> Overloaded<Ts...>;
+vtkStandardNewMacro(vtkObjectEventObserver);
 
 vtkObjectEventObserver::vtkObjectEventObserver()
   : m_updateCommand(vtkSmartPointer<vtkCallbackCommand>::New())
 {
   m_updateCommand->SetClientData(this);
-  m_updateCommand->SetCallback(
-    [](vtkObject* caller, unsigned long eid, void* clientData, void* callData)
-    {
-      auto client = static_cast<vtkObjectEventObserver*>(clientData);
-      try
-      {
-        // Dispatch to callback depending on current std variant content
-        std::visit(Overloaded{ [&](const std::function<void(vtkObject * node)>& f) { f(caller); },
-                               [&](const std::function<void(vtkObject * node, unsigned long eventId)>& f) { f(caller, eid); },
-                               [&](const std::function<void(vtkObject * node, unsigned long eventId, void* callData)>& f) { f(caller, eid, callData); } },
-                   client->m_callback);
-      }
-      catch (const std::bad_function_call&)
-      {
-        // Ignore unset function callbacks
-      }
-    });
+  m_updateCommand->SetCallback(&vtkObjectEventObserver::OnEvent);
 }
 
 vtkObjectEventObserver::~vtkObjectEventObserver()
 {
-  for (const auto& obs : m_obsMap)
+  // Entries of deleted objects are removed on their DeleteEvent, remaining objects are alive
+  for (const auto& observedEvent : m_observedEvents)
   {
-    if (obs.first)
-    {
-      for (auto& event : obs.second)
-      {
-        obs.first->RemoveObserver(event);
-      }
-    }
+    observedEvent.Object->RemoveObserver(observedEvent.Tag);
   }
 }
 
@@ -63,22 +35,30 @@ bool vtkObjectEventObserver::UpdateObserver(vtkObject* prevObj, vtkObject* obj,
     return false;
   }
 
-  RemoveObserver(prevObj);
+  RemoveObjectObservers(prevObj);
   for (const auto& event : events)
   {
-    AddObserver(obj, event);
+    AddEventObserver(obj, event);
   }
   return true;
 }
 
 void vtkObjectEventObserver::SetUpdateCallback(const std::function<void(vtkObject* node)>& callback)
 {
-  m_callback = callback;
+  m_callback = nullptr;
+  if (callback)
+  {
+    m_callback = [callback](vtkObject* node, unsigned long, void*) { callback(node); };
+  }
 }
 
 void vtkObjectEventObserver::SetUpdateCallback(const std::function<void(vtkObject* node, unsigned long eventId)>& callback)
 {
-  m_callback = callback;
+  m_callback = nullptr;
+  if (callback)
+  {
+    m_callback = [callback](vtkObject* node, unsigned long eventId, void*) { callback(node, eventId); };
+  }
 }
 
 void vtkObjectEventObserver::SetUpdateCallback(const std::function<void(vtkObject* node, unsigned long eventId, void* callData)>& callback)
@@ -86,37 +66,261 @@ void vtkObjectEventObserver::SetUpdateCallback(const std::function<void(vtkObjec
   m_callback = callback;
 }
 
-void vtkObjectEventObserver::AddObserver(vtkObject* node, unsigned long event)
+bool vtkObjectEventObserver::AddEventObserver(vtkObject* node, unsigned long event)
 {
   if (!node)
+  {
+    return false;
+  }
+
+  auto deleteIt = LowerBound(node, vtkCommand::DeleteEvent);
+  if (deleteIt == std::end(m_observedEvents) || deleteIt->Object != node || deleteIt->Event != vtkCommand::DeleteEvent)
+  {
+    // Observe the object deletion to remove its entries from the table
+    deleteIt = m_observedEvents.insert(deleteIt, { node, vtkCommand::DeleteEvent, node->AddObserver(vtkCommand::DeleteEvent, m_updateCommand), false, false });
+  }
+
+  if (event == vtkCommand::DeleteEvent)
+  {
+    return !std::exchange(deleteIt->IsForwarded, true);
+  }
+
+  auto it = LowerBound(node, event);
+  if (it != std::end(m_observedEvents) && it->Object == node && it->Event == event)
+  {
+    return false;
+  }
+
+  m_observedEvents.insert(it, { node, event, node->AddObserver(event, m_updateCommand), true, false });
+  return true;
+}
+
+void vtkObjectEventObserver::RemoveEventObserver(vtkObject* node, unsigned long event)
+{
+  auto it = Find(node, event);
+  if (it == std::end(m_observedEvents))
   {
     return;
   }
 
-  if (m_obsMap.find(node) == std::end(m_obsMap))
+  if (it->IsPending)
   {
-    m_obsMap[node] = std::set<unsigned long>{};
+    m_pendingEvents.erase(std::find(std::begin(m_pendingEvents), std::end(m_pendingEvents), std::make_pair(node, event)));
   }
 
-  if (m_obsMap[node].find(event) != std::end(m_obsMap[node]))
+  if (event == vtkCommand::DeleteEvent)
+  {
+    it->IsForwarded = false;
+  }
+  else
+  {
+    node->RemoveObserver(it->Tag);
+    m_observedEvents.erase(it);
+  }
+
+  // Objects without forwarded events don't need to be observed for deletion anymore
+  auto range = FindObject(node);
+  if (std::none_of(range.first, range.second, [](const ObservedEvent& e) { return e.IsForwarded; }))
+  {
+    RemoveObjectObservers(node);
+  }
+}
+
+void vtkObjectEventObserver::RemoveObjectObservers(vtkObject* node)
+{
+  auto range = FindObject(node);
+  if (range.first == range.second)
   {
     return;
   }
 
-  m_obsMap[node].insert(node->AddObserver(event, m_updateCommand));
+  bool isPending = false;
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    node->RemoveObserver(it->Tag);
+    isPending |= it->IsPending;
+  }
+  m_observedEvents.erase(range.first, range.second);
+
+  if (isPending)
+  {
+    m_pendingEvents.erase(std::remove_if(std::begin(m_pendingEvents), std::end(m_pendingEvents), [node](const auto& e) { return e.first == node; }),
+                          std::end(m_pendingEvents));
+  }
+}
+
+int vtkObjectEventObserver::GetNumberOfObservedObjects() const
+{
+  // Each observed object has exactly one DeleteEvent entry
+  return static_cast<int>(std::count_if(std::begin(m_observedEvents), std::end(m_observedEvents), [](const ObservedEvent& e) { return e.Event == vtkCommand::DeleteEvent; }));
+}
+
+int vtkObjectEventObserver::GetNumberOfObservers() const
+{
+  return static_cast<int>(m_observedEvents.size());
+}
+
+unsigned long vtkObjectEventObserver::GetMemorySize() const
+{
+  return static_cast<unsigned long>(sizeof(*this) + m_observedEvents.capacity() * sizeof(ObservedEvent) + m_pendingEvents.capacity() * sizeof(m_pendingEvents[0])
+                                    + m_immediateEvents.capacity() * sizeof(unsigned long));
 }
 
-void vtkObjectEventObserver::RemoveObserver(vtkObject* node)
+void vtkObjectEventObserver::SetCoalescing(bool isEnabled)
 {
-  if (!node || m_obsMap.find(node) == std::end(m_obsMap))
+  if (m_isCoalescing == isEnabled)
   {
     return;
   }
 
-  for (auto& event : m_obsMap[node])
+  m_isCoalescing = isEnabled;
+  if (!m_isCoalescing)
   {
-    node->RemoveObserver(event);
+    Flush();
   }
+}
+
+bool vtkObjectEventObserver::GetCoalescing() const
+{
+  return m_isCoalescing;
+}
 
-  m_obsMap.erase(node);
+void vtkObjectEventObserver::SetEventCoalesced(unsigned long event, bool isCoalesced)
+{
+  auto found = std::find(std::begin(m_immediateEvents), std::end(m_immediateEvents), event);
+  if (isCoalesced && found != std::end(m_immediateEvents))
+  {
+    m_immediateEvents.erase(found);
+  }
+  else if (!isCoalesced && found == std::end(m_immediateEvents))
+  {
+    m_immediateEvents.push_back(event);
+  }
+}
+
+bool vtkObjectEventObserver::IsEventCoalesced(unsigned long event) const
+{
+  // Deleted objects can't be delivered on flush
+  return event != vtkCommand::DeleteEvent && std::find(std::begin(m_immediateEvents), std::end(m_immediateEvents), event) == std::end(m_immediateEvents);
+}
+
+void vtkObjectEventObserver::SetPendingCallback(const std::function<void(vtkObject* node, unsigned long eventId)>& callback)
+{
+  m_pendingCallback = callback;
+}
+
+void vtkObjectEventObserver::Flush()
+{
+  if (m_pendingEvents.empty())
+  {
+    return;
+  }
+
+  // The callbacks may release the last reference to the observer
+  vtkSmartPointer<vtkObjectEventObserver> self = this;
+
+  // Events triggered by the callbacks are pending until the next flush
+  auto pendingEvents = std::move(m_pendingEvents);
+  m_pendingEvents.clear();
+  for (const auto& pendingEvent : pendingEvents)
+  {
+    auto it = Find(pendingEvent.first, pendingEvent.second);
+    if (it != std::end(m_observedEvents))
+    {
+      it->IsPending = false;
+    }
+  }
+
+  for (const auto& pendingEvent : pendingEvents)
+  {
+    // Objects deleted or not observed anymore by the previous callbacks are skipped
+    if (m_callback && Find(pendingEvent.first, pendingEvent.second) != std::end(m_observedEvents))
+    {
+      m_callback(pendingEvent.first, pendingEvent.second, nullptr);
+    }
+  }
+}
+
+int vtkObjectEventObserver::GetNumberOfPendingEvents() const
+{
+  return static_cast<int>(m_pendingEvents.size());
+}
+
+void vtkObjectEventObserver::OnEvent(vtkObject* caller, unsigned long eventId, void* clientData, void* callData)
+{
+  auto client = static_cast<vtkObjectEventObserver*>(clientData);
+  if (eventId == vtkCommand::DeleteEvent)
+  {
+    client->OnObjectDeleted(caller, callData);
+    return;
+  }
+
+  if (client->m_isCoalescing && client->IsEventCoalesced(eventId))
+  {
+    client->AddPendingEvent(caller, eventId);
+    return;
+  }
+
+  if (client->m_callback)
+  {
+    client->m_callback(caller, eventId, callData);
+  }
+}
+
+void vtkObjectEventObserver::OnObjectDeleted(vtkObject* obj, void* callData)
+{
+  // The callback may release the last reference to the observer
+  vtkSmartPointer<vtkObjectEventObserver> self = this;
+
+  auto it = Find(obj, vtkCommand::DeleteEvent);
+  if (it != std::end(m_observedEvents) && it->IsForwarded && m_callback)
+  {
+    m_callback(obj, vtkCommand::DeleteEvent, callData);
+  }
+  RemoveObjectObservers(obj);
+}
+
+void vtkObjectEventObserver::AddPendingEvent(vtkObject* caller, unsigned long eventId)
+{
+  auto it = Find(caller, eventId);
+  if (it == std::end(m_observedEvents) || it->IsPending)
+  {
+    return;
+  }
+
+  it->IsPending = true;
+  m_pendingEvents.emplace_back(caller, eventId);
+  if (m_pendingCallback)
+  {
+    m_pendingCallback(caller, eventId);
+  }
+}
+
+vtkObjectEventObserver::ObservedEventIt vtkObjectEventObserver::LowerBound(vtkObject* obj, unsigned long event)
+{
+  return std::lower_bound(std::begin(m_observedEvents),
+                          std::end(m_observedEvents),
+                          std::make_pair(obj, event),
+                          [](const ObservedEvent& e, const std::pair<vtkObject*, unsigned long>& key)
+                          { return std::less<vtkObject*>{}(e.Object, key.first) || (e.Object == key.first && e.Event < key.second); });
+}
+
+vtkObjectEventObserver::ObservedEventIt vtkObjectEventObserver::Find(vtkObject* obj, unsigned long event)
+{
+  auto it = LowerBound(obj, event);
+  if (it == std::end(m_observedEvents) || it->Object != obj || it->Event != event)
+  {
+    return std::end(m_observedEvents);
+  }
+  return it;
+}
+
+std::pair<vtkObjectEventObserver::ObservedEventIt, vtkObjectEventObserver::ObservedEventIt> vtkObjectEventObserver::FindObject(vtkObject* obj)
+{
+  auto first = std::lower_bound(std::begin(m_observedEvents),
+                                std::end(m_observedEvents),
+                                obj,
+                                [](const ObservedEvent& e, vtkObject* key) { return std::less<vtkObject*>{}(e.Object, key); });
+  auto last = std::find_if(first, std::end(m_observedEvents), [obj](const ObservedEvent& e) { return e.Object != obj; });
+  return { first, last };
 }
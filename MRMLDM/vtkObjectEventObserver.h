@@ -2,15 +2,12 @@
 
 #include "vtkSlicerLayerDMModuleMRMLDisplayableManagerExport.h"
 
-#include <vtkWeakPointer.h>
 #include <vtkSmartPointer.h>
 #include <vtkObject.h>
 #include <vtkCommand.h>
 
 #include <functional>
-#include <map>
-#include <set>
-#include <variant>
+#include <utility>
 #include <vector>
 
 class vtkCallbackCommand;
@@ -19,6 +16,15 @@ class vtkCallbackCommand;
 /// Can observe multiple objects and multiple events per object.
 ///
 /// Depending on the callback used, event id and call data can either be forwarded or ignored.
+/// Callbacks are normalized to the (object, event id, call data) signature when set so that the dispatch of an event
+/// is a single function call.
+///
+/// Observer tags are stored in a flat table sorted on (object, event). Each observed object is also observed for its
+/// DeleteEvent to remove its entries from the table when the object is deleted.
+///
+/// In coalescing mode, the triggered events are recorded in a pending set deduplicated on (object, event) and the
+/// callback is called once per pending pair on \sa Flush. Events whose call data must be delivered immediately can
+/// opt out of the coalescing using \sa SetEventCoalesced.
 class VTK_SLICER_LAYERDM_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkObjectEventObserver : public vtkObject
 {
 public:
@@ -31,19 +37,91 @@ public:
   void SetUpdateCallback(const std::function<void(vtkObject* node, unsigned long eventId)>& callback);
   void SetUpdateCallback(const std::function<void(vtkObject* node, unsigned long eventId, void* callData)>& callback);
 
+  /// Observe the input event of the object. The other observed events of the object are kept.
+  /// \return false if the object is nullptr or the event is already observed.
+  bool AddEventObserver(vtkObject* obj, unsigned long event);
+
+  /// Stop observing the input event of the object. The other observed events of the object are kept.
+  void RemoveEventObserver(vtkObject* obj, unsigned long event);
+
+  /// Stop observing all the events of the object.
+  void RemoveObjectObservers(vtkObject* obj);
+
+  /// Number of objects currently observed.
+  int GetNumberOfObservedObjects() const;
+
+  /// Number of VTK observers added by the observer, including the DeleteEvent observers of the observed objects.
+  int GetNumberOfObservers() const;
+
+  /// Estimated memory used by the observer tag table and the pending events in bytes.
+  unsigned long GetMemorySize() const;
+
+  /// @{
+  /// Coalesce the triggered events until the next \sa Flush. Disabled by default.
+  /// Coalesced events are delivered once per (object, event) in the order of their first occurrence with a nullptr
+  /// call data. Disabling the coalescing flushes the pending events.
+  void SetCoalescing(bool isEnabled);
+  bool GetCoalescing() const;
+  /// @}
+
+  /// @{
+  /// Per-event opt-out of the coalescing for events whose call data must be delivered immediately.
+  /// All events are coalesced by default except DeleteEvent which is always delivered immediately.
+  void SetEventCoalesced(unsigned long event, bool isCoalesced);
+  bool IsEventCoalesced(unsigned long event) const;
+  /// @}
+
+  /// Set the callback triggered when an (object, event) pair is added to the pending set.
+  /// Allows the owner of the observer to schedule the next \sa Flush.
+  void SetPendingCallback(const std::function<void(vtkObject* node, unsigned long eventId)>& callback);
+
+  /// Deliver the pending coalesced events.
+  /// Events of deleted objects and of events not observed anymore are discarded.
+  /// Events coalesced during the flush are delivered on the next flush.
+  void Flush();
+
+  /// Number of (object, event) pairs waiting for the next \sa Flush.
+  int GetNumberOfPendingEvents() const;
+
 protected:
   vtkObjectEventObserver();
   ~vtkObjectEventObserver() override;
 
 private:
-  void AddObserver(vtkObject* obj, unsigned long event);
-  void RemoveObserver(vtkObject* obj);
+  struct ObservedEvent
+  {
+    vtkObject* Object{ nullptr };
+    unsigned long Event{ 0 };
+    unsigned long Tag{ 0 };
+    // false for the DeleteEvent observers only used to clean up the table
+    bool IsForwarded{ true };
+    bool IsPending{ false };
+  };
+  using ObservedEventIt = std::vector<ObservedEvent>::iterator;
+
+  static void OnEvent(vtkObject* caller, unsigned long eventId, void* clientData, void* callData);
+  void OnObjectDeleted(vtkObject* obj, void* callData);
+  void AddPendingEvent(vtkObject* caller, unsigned long eventId);
+
+  /// Returns the first entry not ordered before the (object, event) pair.
+  ObservedEventIt LowerBound(vtkObject* obj, unsigned long event);
+
+  /// Returns the entry of the (object, event) pair or the end of the table.
+  ObservedEventIt Find(vtkObject* obj, unsigned long event);
+
+  /// Returns the range of the entries of the object.
+  std::pair<ObservedEventIt, ObservedEventIt> FindObject(vtkObject* obj);
 
   vtkSmartPointer<vtkCallbackCommand> m_updateCommand{};
-  std::map<vtkWeakPointer<vtkObject>, std::set<unsigned long>> m_obsMap{};
+  std::function<void(vtkObject* node, unsigned long eventId, void* callData)> m_callback{};
+
+  // Observed events sorted on (object, event). Entries are removed on the object DeleteEvent.
+  std::vector<ObservedEvent> m_observedEvents{};
+
+  bool m_isCoalescing{ false };
+  std::vector<unsigned long> m_immediateEvents{};
+  std::function<void(vtkObject* node, unsigned long eventId)> m_pendingCallback{};
 
-  std::variant<std::function<void(vtkObject* node)>,
-               std::function<void(vtkObject* node, unsigned long eventId)>,
-               std::function<void(vtkObject* node, unsigned long eventId, void* callData)>>
-    m_callback;
+  // Pending events in order of first occurrence, deduplicated using the IsPending flag of the table entries
+  std::vector<std::pair<vtkObject*, unsigned long>> m_pendingEvents{};
 };
@@ -0,0 +1,109 @@
+#include "vtkMRMLLayerDMInteractionLogic.h"
+#include "vtkMRMLLayerDMPipelineI.h"
+
+#include <vtkMRMLAbstractWidget.h>
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLInteractionEventData.h>
+
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+/// Thread-safe pipeline answering the interaction events with fixed values.
+/// Python pipelines are never thread-safe and can't cover the parallel evaluation of the interaction logic.
+class FixedInteractionPipeline : public vtkMRMLLayerDMPipelineI
+{
+public:
+  static FixedInteractionPipeline* New();
+  vtkTypeMacro(FixedInteractionPipeline, vtkMRMLLayerDMPipelineI);
+
+  bool CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2) override
+  {
+    distance2 = m_distance2;
+    return m_canProcess;
+  }
+
+  bool IsCanProcessInteractionEventThreadSafe() const override { return true; }
+  unsigned int GetRenderLayer() const override { return m_renderLayer; }
+  int GetWidgetState() const override { return m_widgetState; }
+
+  bool m_canProcess{ false };
+  double m_distance2{ VTK_DOUBLE_MAX };
+  unsigned int m_renderLayer{ 0 };
+  int m_widgetState{ vtkMRMLAbstractWidget::WidgetStateIdle };
+
+protected:
+  FixedInteractionPipeline() = default;
+  ~FixedInteractionPipeline() override = default;
+};
+
+vtkStandardNewMacro(FixedInteractionPipeline);
+
+std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> EvaluateCanProcessPipelines(const std::vector<vtkSmartPointer<FixedInteractionPipeline>>& pipelines,
+                                                                                 bool isParallel,
+                                                                                 double& distance2,
+                                                                                 bool& canProcess)
+{
+  vtkNew<vtkMRMLLayerDMInteractionLogic> logic;
+  logic->SetParallelEvaluation(isParallel);
+  for (const auto& pipeline : pipelines)
+  {
+    logic->AddPipeline(pipeline);
+  }
+
+  vtkNew<vtkMRMLInteractionEventData> eventData;
+  canProcess = logic->CanProcessInteractionEvent(eventData, distance2);
+  return logic->GetCanProcessPipelines();
+}
+} // namespace
+
+int vtkMRMLLayerDMInteractionLogicParallelTest(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Many ties of distance, layer and widget state, and pipelines refusing the event
+  std::mt19937 rng(42);
+  auto randomInt = [&rng](int min, int max) { return std::uniform_int_distribution<int>(min, max)(rng); };
+  std::vector<vtkSmartPointer<FixedInteractionPipeline>> pipelines;
+  for (int i = 0; i < 500; ++i)
+  {
+    auto pipeline = vtkSmartPointer<FixedInteractionPipeline>::New();
+    pipeline->m_canProcess = randomInt(0, 9) < 7;
+    pipeline->m_distance2 = randomInt(0, 3);
+    pipeline->m_renderLayer = randomInt(0, 1);
+    pipeline->m_widgetState = randomInt(0, 1) ? vtkMRMLAbstractWidget::WidgetStateOnWidget : vtkMRMLAbstractWidget::WidgetStateIdle;
+    pipelines.emplace_back(pipeline);
+  }
+
+  double parallelDistance2 = 0;
+  double serialDistance2 = 0;
+  bool isParallelCanProcess = false;
+  bool isSerialCanProcess = false;
+  auto parallelSelection = EvaluateCanProcessPipelines(pipelines, true, parallelDistance2, isParallelCanProcess);
+  auto serialSelection = EvaluateCanProcessPipelines(pipelines, false, serialDistance2, isSerialCanProcess);
+  CHECK_BOOL(isParallelCanProcess, true);
+  CHECK_BOOL(isSerialCanProcess, true);
+  CHECK_BOOL(parallelDistance2 == serialDistance2, true);
+
+  // Same selection and order, ties keeping the insertion order
+  CHECK_BOOL(parallelSelection == serialSelection, true);
+
+  std::vector<vtkSmartPointer<vtkMRMLLayerDMPipelineI>> expected;
+  std::copy_if(pipelines.begin(), pipelines.end(), std::back_inserter(expected), [](const auto& p) { return p->m_canProcess; });
+  auto priority = [](const vtkSmartPointer<vtkMRMLLayerDMPipelineI>& p)
+  {
+    auto pipeline = FixedInteractionPipeline::SafeDownCast(p);
+    return std::make_tuple(std::max(pipeline->m_widgetState, static_cast<int>(vtkMRMLAbstractWidget::WidgetStateOnWidget)), pipeline->m_renderLayer, -pipeline->m_distance2);
+  };
+  std::stable_sort(expected.begin(), expected.end(), [&priority](const auto& lhs, const auto& rhs) { return priority(lhs) > priority(rhs); });
+  CHECK_BOOL(parallelSelection == expected, true);
+  CHECK_BOOL(expected.size() < pipelines.size(), true);
+
+  return EXIT_SUCCESS;
+}
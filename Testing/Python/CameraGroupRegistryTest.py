@@ -0,0 +1,97 @@
+import slicer
+from slicer import vtkMRMLLayerDMCameraGroupRegistry, vtkMRMLLayerDMPipelineManager
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkCamera, vtkCommand, vtkRenderWindow, vtkRenderer
+
+
+class CameraGroupRegistryTest(ScriptedLoadableModuleTest):
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.registry = vtkMRMLLayerDMCameraGroupRegistry.GetInstance()
+        self.views = [self.createView() for _ in range(3)]
+
+    def tearDown(self):
+        for view in self.views:
+            view["manager"].SetCameraGroup("")
+
+    @staticmethod
+    def createView():
+        renderWindow = vtkRenderWindow()
+        renderer = vtkRenderer()
+        renderer.SetActiveCamera(vtkCamera())
+        renderWindow.AddRenderer(renderer)
+
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetViewNode(slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode"))
+        pipelineManager.SetRenderWindow(renderWindow)
+        pipelineManager.SetRenderer(renderer)
+        return {"renderWindow": renderWindow, "renderer": renderer, "manager": pipelineManager}
+
+    def joinGroup(self, groupName="linked"):
+        for view in self.views:
+            view["manager"].SetCameraGroup(groupName)
+
+    def test_views_of_a_group_share_the_group_camera(self):
+        nGroups = self.registry.GetNumberOfGroups()
+        viewCameras = [view["manager"].GetDefaultCamera() for view in self.views]
+        self.joinGroup()
+
+        groupCamera = self.registry.GetGroupCamera("linked")
+        assert self.registry.GetNumberOfGroups() == nGroups + 1
+        assert self.registry.GetNumberOfMembers("linked") == 3
+        assert all(view["manager"].GetDefaultCamera() == groupCamera for view in self.views)
+
+        for view in self.views:
+            view["manager"].SetCameraGroup("")
+        assert self.registry.GetNumberOfGroups() == nGroups
+        assert [view["manager"].GetDefaultCamera() for view in self.views] == viewCameras
+
+    def test_group_camera_is_synchronized_by_the_first_view_only(self):
+        self.joinGroup()
+        leader, follower = self.views[0], self.views[1]
+        assert self.registry.GetGroupSynchronizer("linked") == leader["manager"]
+
+        leader["renderer"].GetActiveCamera().SetPosition(1, 2, 3)
+        assert self.registry.GetGroupCamera("linked").GetPosition() == (1, 2, 3)
+
+        follower["renderer"].GetActiveCamera().SetPosition(4, 5, 6)
+        assert self.registry.GetGroupCamera("linked").GetPosition() == (1, 2, 3)
+
+        # The next view takes over the synchronization when the first view leaves
+        leader["manager"].SetCameraGroup("")
+        assert self.registry.GetGroupSynchronizer("linked") == follower["manager"]
+        follower["renderer"].GetActiveCamera().SetPosition(7, 8, 9)
+        assert self.registry.GetGroupCamera("linked").GetPosition() == (7, 8, 9)
+
+    def test_group_clipping_range_is_computed_once_per_frame(self):
+        self.joinGroup()
+        self.registry.UpdateClippingRange("linked")
+        nUpdates = self.registry.GetNumberOfClippingRangeUpdates("linked")
+
+        for view in self.views:
+            view["manager"].RequestRender()
+        for view in self.views:
+            view["renderWindow"].InvokeEvent(vtkCommand.StartEvent)
+        assert self.registry.GetNumberOfClippingRangeUpdates("linked") == nUpdates + 1
+
+        # Frames without clipping range reset request don't compute the range
+        for view in self.views:
+            view["renderWindow"].InvokeEvent(vtkCommand.StartEvent)
+        assert self.registry.GetNumberOfClippingRangeUpdates("linked") == nUpdates + 1
+
+    def test_deleted_views_leave_their_group(self):
+        self.joinGroup()
+        view = self.views.pop()
+        del view
+        assert self.registry.GetNumberOfMembers("linked") == 2
+
+    def test_deleted_synchronizer_view_hands_over_the_group(self):
+        self.joinGroup()
+        assert self.registry.GetNumberOfMembers("linked") == 3
+
+        del self.views[0]
+        assert self.registry.GetNumberOfMembers("linked") == 2
+        assert self.registry.GetGroupSynchronizer("linked") == self.views[0]["manager"]
+
+        self.views.clear()
+        assert self.registry.GetNumberOfMembers("linked") == 0
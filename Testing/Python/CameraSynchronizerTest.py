@@ -1,7 +1,7 @@
 import slicer
 from slicer import vtkMRMLLayerDMCameraSynchronizer, vtkMRMLViewNode, vtkMRMLLayerDMPipelineManager, vtkMRMLSliceNode
 from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
-from vtk import vtkRenderWindow, vtkRenderer, vtkCamera
+from vtk import vtkCommand, vtkRenderWindow, vtkRenderer, vtkCamera, vtkTransform
 
 
 class CameraSynchronizerTest(ScriptedLoadableModuleTest):
@@ -41,3 +41,154 @@ class CameraSynchronizerTest(ScriptedLoadableModuleTest):
 
         sliceNode.SetXYZOrigin([1, 2, 3])
         assert preMTime != self.defaultCam.GetMTime()
+
+    def test_changed_parameters_sync_skips_unchanged_camera(self):
+        cam1 = vtkCamera()
+        self.cameraSync.SetViewNode(vtkMRMLViewNode())
+        self.renderer.SetActiveCamera(cam1)
+        assert self.cameraSync.GetSyncMode() == vtkMRMLLayerDMCameraSynchronizer.SyncChangedParameters
+
+        # Count the camera modifications outside of the synchronization
+        nModified = []
+        self.defaultCam.AddObserver(vtkCommand.ModifiedEvent, lambda *_: nModified.append(True) if not self.cameraSync.IsSynchronizing() else None)
+
+        # Modifications not affecting the view parameters are not propagated
+        cam1.SetClippingRange(1, 2)
+        cam1.Modified()
+        assert nModified == []
+
+        # Changed parameters are copied with a single modification of the default camera
+        cam1.SetPosition(1, 2, 3)
+        cam1.SetViewAngle(45)
+        cam1.Modified()
+        assert self.defaultCam.GetPosition() == (1, 2, 3)
+        assert self.defaultCam.GetViewAngle() == 45
+        assert len(nModified) == 2
+
+    def test_changed_parameters_sync_copies_transforms_and_stereo_parameters(self):
+        cam1 = vtkCamera()
+        self.cameraSync.SetViewNode(vtkMRMLViewNode())
+        self.renderer.SetActiveCamera(cam1)
+
+        userTransform = vtkTransform()
+        userViewTransform = vtkTransform()
+        cam1.SetUserTransform(userTransform)
+        cam1.SetUserViewTransform(userViewTransform)
+        cam1.SetEyeAngle(5)
+        cam1.SetViewShear(0.1, 0.2, 1.0)
+        cam1.Modified()
+
+        assert self.defaultCam.GetUserTransform() == userTransform
+        assert self.defaultCam.GetUserViewTransform() == userViewTransform
+        assert self.defaultCam.GetEyeAngle() == 5
+        assert self.defaultCam.GetViewShear() == (0.1, 0.2, 1.0)
+
+    def test_deep_copy_sync_modifies_camera_on_each_modification(self):
+        cam1 = vtkCamera()
+        self.cameraSync.SetSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncDeepCopy)
+        self.cameraSync.SetViewNode(vtkMRMLViewNode())
+        self.renderer.SetActiveCamera(cam1)
+
+        preMTime = self.defaultCam.GetMTime()
+        cam1.Modified()
+        assert preMTime != self.defaultCam.GetMTime()
+
+    def test_shared_camera_sync_uses_renderer_camera(self):
+        cam1 = vtkCamera()
+        self.cameraSync.SetViewNode(vtkMRMLViewNode())
+        self.renderer.SetActiveCamera(cam1)
+        assert self.cameraSync.GetSynchronizedCamera() == self.defaultCam
+
+        cameraChanges = []
+        self.cameraSync.AddObserver(vtkCommand.ActiveCameraEvent, lambda *_: cameraChanges.append(True))
+        self.cameraSync.SetSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncSharedCamera)
+        assert self.cameraSync.GetSynchronizedCamera() == cam1
+
+        cam2 = vtkCamera()
+        self.renderer.SetActiveCamera(cam2)
+        assert self.cameraSync.GetSynchronizedCamera() == cam2
+        assert len(cameraChanges) == 2
+
+        # Slice views always copy the camera
+        self.cameraSync.SetViewNode(vtkMRMLSliceNode())
+        assert self.cameraSync.GetSynchronizedCamera() == self.defaultCam
+
+    def test_pipeline_manager_default_camera_follows_shared_camera(self):
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetRenderWindow(self.renderWindow)
+        pipelineManager.SetRenderer(self.renderer)
+        pipelineManager.SetViewNode(slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode"))
+        copiedCamera = pipelineManager.GetDefaultCamera()
+
+        pipelineManager.SetCameraSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncSharedCamera)
+        assert pipelineManager.GetDefaultCamera() == self.renderer.GetActiveCamera()
+
+        pipelineManager.SetCameraSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncChangedParameters)
+        assert pipelineManager.GetDefaultCamera() == copiedCamera
+
+    def test_pipeline_manager_applies_slice_clipping_slab_thickness_changes(self):
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetRenderWindow(self.renderWindow)
+        pipelineManager.SetRenderer(self.renderer)
+        sliceNode = slicer.mrmlScene.AddNewNodeByClass("vtkMRMLSliceNode")
+        sliceNode.SetDimensions(256, 256, 1)
+        sliceNode.SetFieldOfView(100, 100, 1)
+        pipelineManager.SetViewNode(sliceNode)
+
+        renderRequests = []
+        pipelineManager.SetRequestRender(lambda: renderRequests.append(True))
+        pipelineManager.SetSliceClippingSlabThickness(4)
+        assert pipelineManager.GetSliceClippingSlabThickness() == 4
+        assert renderRequests
+
+        # The slice camera is moved away from the slice plane to fit the slab of 400 in front of it
+        assert pipelineManager.GetDefaultCamera().GetDistance() >= 400
+
+    def test_slice_view_skips_updates_with_unchanged_camera_inputs(self):
+        sliceNode = vtkMRMLSliceNode()
+        sliceNode.SetDimensions(256, 256, 1)
+        sliceNode.SetFieldOfView(100, 100, 1)
+        self.cameraSync.SetViewNode(sliceNode)
+        self.cameraSync.ResetUpdateCounters()
+        preMTime = self.defaultCam.GetMTime()
+
+        # Modifications not affecting the camera inputs are skipped without modifying the camera
+        sliceNode.Modified()
+        sliceNode.Modified()
+        assert self.cameraSync.GetNumberOfAppliedUpdates() == 0
+        assert self.cameraSync.GetNumberOfSkippedUpdates() == 2
+        assert preMTime == self.defaultCam.GetMTime()
+
+        sliceNode.SetFieldOfView(200, 200, 1)
+        assert self.cameraSync.GetNumberOfAppliedUpdates() >= 1
+        assert self.defaultCam.GetParallelScale() == 100
+        assert preMTime != self.defaultCam.GetMTime()
+
+    def test_slice_view_provides_clipping_slab_around_slice_plane(self):
+        clippingRange = [0, 0]
+        self.cameraSync.SetViewNode(vtkMRMLViewNode())
+        assert not self.cameraSync.GetDefaultCameraClippingRange(clippingRange)
+
+        sliceNode = vtkMRMLSliceNode()
+        sliceNode.SetDimensions(256, 256, 1)
+        sliceNode.SetFieldOfView(100, 200, 1)
+        self.cameraSync.SetViewNode(sliceNode)
+        self.defaultCam.SetDistance(500)
+        self.cameraSync.SetSliceClippingSlabThickness(0.5)
+        assert self.cameraSync.GetDefaultCameraClippingRange(clippingRange)
+        assert abs(clippingRange[0] - 450) < 1e-6
+        assert abs(clippingRange[1] - 550) < 1e-6
+
+    def test_slice_view_clipping_slab_is_centered_on_slice_plane(self):
+        sliceNode = vtkMRMLSliceNode()
+        sliceNode.SetDimensions(256, 256, 1)
+        sliceNode.SetFieldOfView(100, 200, 1)
+        self.cameraSync.SetViewNode(sliceNode)
+
+        # The slice camera is moved away from the slice plane for the slab to fit in front of it
+        for thickness in [1.0, 10.0]:
+            self.cameraSync.SetSliceClippingSlabThickness(thickness)
+            clippingRange = [0, 0]
+            assert self.cameraSync.GetDefaultCameraClippingRange(clippingRange)
+            assert abs(clippingRange[0] - (self.defaultCam.GetDistance() - 100 * thickness)) < 1e-6
+            assert abs(clippingRange[1] - (self.defaultCam.GetDistance() + 100 * thickness)) < 1e-6
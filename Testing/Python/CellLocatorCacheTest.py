@@ -0,0 +1,93 @@
+import time
+
+import slicer
+from slicer import vtkMRMLLayerDMCellLocatorCache, vtkMRMLLayerDMPipelineManager
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkPolyData, vtkSphereSource
+
+
+def createSphere(resolution=16) -> vtkPolyData:
+    sphere = vtkSphereSource()
+    sphere.SetThetaResolution(resolution)
+    sphere.SetPhiResolution(resolution)
+    sphere.Update()
+    return sphere.GetOutput()
+
+
+class CellLocatorCacheTest(ScriptedLoadableModuleTest):
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.cache = vtkMRMLLayerDMCellLocatorCache()
+
+    def test_pipeline_manager_returns_shared_instance(self):
+        assert vtkMRMLLayerDMPipelineManager().GetCellLocatorCache() == vtkMRMLLayerDMCellLocatorCache.GetInstance()
+        assert vtkMRMLLayerDMPipelineManager().GetCellLocatorCache() == vtkMRMLLayerDMCellLocatorCache.GetInstance()
+
+    def test_empty_poly_data_has_no_locator(self):
+        assert self.cache.GetLocator(None) is None
+        assert self.cache.GetLocator(vtkPolyData()) is None
+
+    def test_same_poly_data_returns_same_locator(self):
+        polyData = createSphere()
+        locator = self.cache.GetLocator(polyData)
+        assert locator is not None
+        assert self.cache.GetLocator(polyData) == locator
+        assert self.cache.GetNumberOfLocators() == 1
+
+    def test_modified_poly_data_rebuilds_locator(self):
+        polyData = createSphere()
+        locator = self.cache.GetLocator(polyData)
+        polyData.Modified()
+        assert self.cache.GetLocator(polyData) != locator
+        assert self.cache.GetNumberOfLocators() == 1
+
+    def test_deleted_poly_data_locators_are_evicted(self):
+        polyData = createSphere()
+        self.cache.GetLocator(polyData)
+        del polyData
+
+        self.cache.GetLocator(createSphere())
+        assert self.cache.GetNumberOfLocators() == 1
+
+    def test_least_recently_used_locators_are_evicted_above_memory_cap(self):
+        polyDatas = [createSphere() for _ in range(3)]
+        for polyData in polyDatas:
+            self.cache.GetLocator(polyData)
+        assert self.cache.GetNumberOfLocators() == 3
+
+        self.cache.GetLocator(polyDatas[0])
+        self.cache.SetMemoryCapInKiB(0)
+        assert self.cache.GetNumberOfLocators() == 1
+        assert self.cache.GetLocatorIfReady(polyDatas[0]) is not None
+
+    def test_asynchronous_build_eventually_returns_locator(self):
+        self.cache.SetAsynchronousBuild(True)
+        polyData = createSphere(256)
+        locator = self.cache.GetLocatorIfReady(polyData)
+        deadline = time.monotonic() + 30
+        while locator is None and time.monotonic() < deadline:
+            time.sleep(0.001)
+            locator = self.cache.GetLocatorIfReady(polyData)
+
+        assert locator is not None, "Asynchronous locator build did not complete"
+        assert self.cache.GetLocator(polyData) == locator
+
+    def test_locators_are_built_on_a_copy_of_the_poly_data(self):
+        polyData = createSphere()
+        locator = self.cache.GetLocator(polyData)
+        assert locator.GetDataSet().GetPoints().GetData() != polyData.GetPoints().GetData()
+        assert locator.GetDataSet().GetPolys().GetConnectivityArray() != polyData.GetPolys().GetConnectivityArray()
+
+        # Editing the polydata doesn't modify the locator data
+        polyData.GetPoints().SetPoint(0, 100, 100, 100)
+        assert locator.GetDataSet().GetPoint(0) != (100, 100, 100)
+
+    def test_removed_asynchronous_builds_are_discarded_and_joined(self):
+        self.cache.SetAsynchronousBuild(True)
+        polyData = createSphere(256)
+        assert self.cache.GetLocatorIfReady(polyData) is None
+
+        # Removing the pending build doesn't wait for it, its worker is joined with the cache
+        self.cache.RemoveLocator(polyData)
+        assert self.cache.GetNumberOfLocators() == 0
+        self.cache = None
@@ -0,0 +1,57 @@
+import slicer
+from slicer import vtkMRMLLayerDMInteractionContext, vtkMRMLInteractionEventData
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkRenderWindow, vtkRenderer, vtkPoints
+
+
+class InteractionContextTest(ScriptedLoadableModuleTest):
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.renderWindow = vtkRenderWindow()
+        self.renderWindow.SetSize(200, 100)
+        self.renderer = vtkRenderer()
+        self.renderWindow.AddRenderer(self.renderer)
+
+        self.camera = self.renderer.GetActiveCamera()
+        self.camera.SetPosition(0, 0, 10)
+        self.camera.SetFocalPoint(0, 0, 0)
+
+        self.event = vtkMRMLInteractionEventData()
+        self.event.SetDisplayPosition([100, 50])
+        self.context = vtkMRMLLayerDMInteractionContext()
+        self.context.Update(self.renderer, self.event)
+
+    def test_focal_point_is_projected_to_viewport_center(self):
+        display = [0.0, 0.0]
+        assert self.context.WorldToDisplay([0, 0, 0], display)
+        self.assertAlmostEqual(display[0], 100)
+        self.assertAlmostEqual(display[1], 50)
+
+    def test_points_behind_camera_are_not_projected(self):
+        display = [0.0, 0.0]
+        assert not self.context.WorldToDisplay([0, 0, 20], display)
+
+    def test_min_display_distance_is_the_closest_projected_point(self):
+        points = vtkPoints()
+        points.InsertNextPoint(5, 0, 0)
+        points.InsertNextPoint(0, 0, 0)
+        points.InsertNextPoint(-5, 0, 0)
+        self.assertAlmostEqual(self.context.ComputeMinDisplayDistance2(points), 0)
+
+    def test_pick_ray_goes_through_display_position(self):
+        origin = [0.0, 0.0, 0.0]
+        direction = [0.0, 0.0, 0.0]
+        assert self.context.GetPickRay(origin, direction)
+        self.assertAlmostEqual(origin[0], 0)
+        self.assertAlmostEqual(origin[1], 0)
+        self.assertAlmostEqual(direction[2], -1)
+
+    def test_projection_is_updated_on_camera_modified(self):
+        self.camera.SetPosition(10, 0, 10)
+        self.camera.SetFocalPoint(10, 0, 0)
+        self.context.Update(self.renderer, self.event)
+
+        display = [0.0, 0.0]
+        assert self.context.WorldToDisplay([10, 0, 0], display)
+        self.assertAlmostEqual(display[0], 100)
+        self.assertAlmostEqual(display[1], 50)
@@ -1,5 +1,9 @@
 import slicer
-from slicer import vtkMRMLLayerDMInteractionLogic, vtkMRMLInteractionEventData, vtkMRMLAbstractWidget
+from slicer import (
+    vtkMRMLAbstractWidget,
+    vtkMRMLInteractionEventData,
+    vtkMRMLLayerDMInteractionLogic,
+)
 from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
 from vtk import reference, vtkCommand
 
@@ -105,3 +109,137 @@ class InteractionLogicTest(ScriptedLoadableModuleTest):
         p2.mockProcess.assert_called_once_with(self.event)
 
         assert self.logic.GetLastFocusedPipeline() == p2
+
+    def test_with_hover_coalescing_defers_hover_events_until_render_finished(self):
+        pipeline = MockPipeline(canProcess=True, didProcess=True)
+        self.logic.AddPipeline(pipeline)
+        self.logic.SetHoverCoalescing(True)
+        self.logic.OnRenderRequested()
+        self.event.SetType(vtkCommand.MouseMoveEvent)
+
+        for _ in range(5):
+            assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+            assert self.logic.ProcessInteractionEvent(self.event)
+
+        assert pipeline.mockCanProcess.call_count == 1
+        assert pipeline.mockProcess.call_count == 1
+        assert self.logic.HasPendingHoverEvent()
+
+        self.logic.OnRenderFinished()
+        assert not self.logic.HasPendingHoverEvent()
+        assert pipeline.mockCanProcess.call_count == 2
+        assert pipeline.mockProcess.call_count == 2
+
+    def test_with_hover_coalescing_never_coalesces_button_events(self):
+        pipeline = MockPipeline(canProcess=True, didProcess=True)
+        self.logic.AddPipeline(pipeline)
+        self.logic.SetHoverCoalescing(True)
+        self.logic.OnRenderRequested()
+
+        self.event.SetType(vtkCommand.MouseMoveEvent)
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.logic.HasPendingHoverEvent()
+
+        self.event.SetType(vtkCommand.LeftButtonPressEvent)
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.logic.ProcessInteractionEvent(self.event)
+        assert not self.logic.HasPendingHoverEvent()
+        assert pipeline.mockCanProcess.call_count == 2
+        pipeline.mockProcess.assert_called_once_with(self.event)
+
+    def test_with_hover_rate_limit_coalesces_hover_events_without_render(self):
+        pipeline = MockPipeline(canProcess=True, didProcess=True)
+        self.logic.AddPipeline(pipeline)
+        self.logic.SetHoverCoalescing(True)
+        self.logic.SetMaxHoverDispatchRate(1e-3)
+        self.event.SetType(vtkCommand.MouseMoveEvent)
+
+        for _ in range(5):
+            assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+
+        assert pipeline.mockCanProcess.call_count == 1
+        assert self.logic.HasPendingHoverEvent()
+
+    def test_scripted_pipelines_are_batched_and_keep_their_priority(self):
+        from slicer import vtkMRMLLayerDMPipelineI
+
+        pipelines = [MockPipeline(canProcess=(i % 2 == 0), didProcess=True, processDistance=10 - i) for i in range(6)]
+        self.logic.AddPipeline(vtkMRMLLayerDMPipelineI())
+        for pipeline in pipelines:
+            self.logic.AddPipeline(pipeline)
+
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.distance == 6
+        assert self.logic.ProcessInteractionEvent(self.event)
+        for pipeline in pipelines:
+            pipeline.mockCanProcess.assert_called_once_with(self.event)
+        pipelines[4].mockProcess.assert_called_once_with(self.event)
+
+    def test_scripted_pipelines_priority_is_queried_with_the_batch(self):
+        from unittest.mock import MagicMock
+
+        pipelines = [MockPipeline(canProcess=(i != 1), processDistance=1) for i in range(4)]
+        for layer, pipeline in enumerate(pipelines):
+            pipeline.GetRenderLayer = MagicMock(return_value=layer)
+            pipeline.GetWidgetState = MagicMock(return_value=vtkMRMLAbstractWidget.WidgetStateIdle)
+            pipeline.InvalidatePythonMethodCache()
+            self.logic.AddPipeline(pipeline)
+            pipeline.GetRenderLayer.reset_mock()
+
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.logic.GetCanProcessPipeline(0) == pipelines[-1]
+
+        # The priority is only queried once for the pipelines which can process the event
+        for pipeline in pipelines:
+            expectedCallCount = 1 if pipeline.mockCanProcess.return_value[0] else 0
+            assert pipeline.GetWidgetState.call_count == expectedCallCount
+            assert pipeline.GetRenderLayer.call_count == expectedCallCount
+
+    def test_scripted_pipelines_priority_is_queried_in_the_batch_gil_section(self):
+        pipelines = [MockPipeline(layer=i, canProcess=True, processDistance=1) for i in range(4)]
+        for pipeline in pipelines:
+            pipeline.SetProfilingEnabled(True)
+            self.logic.AddPipeline(pipeline)
+
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        assert self.logic.GetCanProcessPipeline(0) == pipelines[-1]
+
+        # The GIL is acquired once for the whole batch, the widget state and layer queries are part of the batch
+        gilAcquisitions = sum(
+            pipeline.GetProfilingGilAcquisitionCount(name) for pipeline in pipelines for name in pipeline.GetProfiledMethodNames()
+        )
+        assert gilAcquisitions == 1
+        for pipeline in pipelines:
+            assert pipeline.GetProfilingCallCount("GetWidgetState") == 1
+            assert pipeline.GetProfilingCallCount("GetRenderLayer") == 1
+
+    def test_interaction_contexts_are_built_on_request(self):
+        from vtk import vtkRenderer
+
+        renderer = vtkRenderer()
+        assert self.logic.GetInteractionContext(renderer) is None
+
+        contexts = []
+
+        def canProcess(_eventData):
+            contexts.append(self.logic.GetInteractionContext(renderer))
+            return True, 0
+
+        pipeline = MockPipeline()
+        pipeline.mockCanProcess.side_effect = canProcess
+        self.logic.AddPipeline(pipeline)
+        self.logic.AddPipeline(MockPipeline(canProcess=True))
+
+        self.event.SetDisplayPosition([10, 20])
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        context = self.logic.GetInteractionContext(renderer)
+        assert contexts == [context]
+        assert context.GetRenderer() == renderer
+
+        # The context of the renderer is refreshed with the next event
+        self.event.SetDisplayPosition([30, 40])
+        assert self.logic.CanProcessInteractionEvent(self.event, self.distance)
+        position = [0.0, 0.0]
+        self.logic.GetInteractionContext(renderer).GetDisplayPosition(position)
+        assert position == [30, 40]
@@ -0,0 +1,121 @@
+import os
+import struct
+import tempfile
+
+import slicer
+from slicer import (
+    vtkMRMLInteractionEventData,
+    vtkMRMLLayerDMInteractionRecorder,
+    vtkMRMLLayerDMPipelineFactory,
+    vtkMRMLLayerDMPipelineManager,
+    vtkMRMLLayerDMPipelineScriptedCreator,
+    vtkMRMLMarkupsFiducialNode,
+)
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkCommand, vtkRenderer, reference as ref
+
+from MockPipeline import MockPipeline
+
+
+class InteractionRecorderTest(ScriptedLoadableModuleTest):
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.tmpDir = tempfile.TemporaryDirectory()
+        self.recordingPath = os.path.join(self.tmpDir.name, "interactions.ldmi")
+
+        self.factory = vtkMRMLLayerDMPipelineFactory()
+        self.pipelineManager = vtkMRMLLayerDMPipelineManager()
+        self.pipelineManager.SetViewNode(slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode"))
+        self.pipelineManager.SetFactory(self.factory)
+        self.pipelineManager.SetScene(slicer.mrmlScene)
+
+        self.pipelines = [MockPipeline(layer=1), MockPipeline(layer=2)]
+        self.nextPipeline = None
+        creator = vtkMRMLLayerDMPipelineScriptedCreator()
+        creator.SetPythonCallback(lambda *_: self.nextPipeline)
+        self.factory.AddPipelineCreator(creator)
+        for pipeline in self.pipelines:
+            self.nextPipeline = pipeline
+            self.pipelineManager.AddNode(vtkMRMLMarkupsFiducialNode())
+
+        self.recorder = vtkMRMLLayerDMInteractionRecorder()
+
+    def tearDown(self):
+        self.recorder.StopRecording()
+        self.tmpDir.cleanup()
+
+    def sendEvents(self, nEvents):
+        for i in range(nEvents):
+            event = vtkMRMLInteractionEventData()
+            event.SetType(vtkCommand.MouseMoveEvent)
+            event.SetDisplayPosition([i, 2 * i])
+            if self.pipelineManager.CanProcessInteractionEvent(event, ref(0.0)):
+                self.pipelineManager.ProcessInteractionEvent(event)
+
+    def test_records_events_going_through_pipeline_manager(self):
+        assert self.recorder.StartRecording(self.recordingPath)
+        self.pipelineManager.SetInteractionRecorder(self.recorder)
+        self.sendEvents(10)
+        self.recorder.StopRecording()
+
+        assert self.recorder.GetNumberOfRecordedEvents() == 10
+        assert os.path.getsize(self.recordingPath) > 0
+
+    def test_replay_sends_recorded_events_and_reports_latencies(self):
+        assert self.recorder.StartRecording(self.recordingPath)
+        self.pipelineManager.SetInteractionRecorder(self.recorder)
+        self.sendEvents(10)
+        self.recorder.StopRecording()
+        self.pipelineManager.SetInteractionRecorder(None)
+
+        self.pipelines[0].mockCanProcess.reset_mock()
+        self.pipelines[0].mockCanProcess.return_value = (True, 0)
+        self.pipelines[0].mockProcess.return_value = True
+
+        assert self.recorder.Replay(self.recordingPath, self.pipelineManager)
+        assert self.recorder.GetNumberOfReplayedEvents() == 10
+        assert self.pipelines[0].mockCanProcess.call_count == 10
+        assert self.pipelines[0].mockProcess.call_count == 10
+        assert self.recorder.GetNumberOfFocusChanges() == 1
+
+        replayed = self.pipelines[0].mockProcess.call_args[0][0]
+        assert replayed.GetType() == vtkCommand.MouseMoveEvent
+        assert list(replayed.GetDisplayPosition()) == [9, 18]
+
+        assert 0 <= self.recorder.GetCanProcessLatencyPercentile(50) <= self.recorder.GetCanProcessLatencyPercentile(99)
+        assert 0 <= self.recorder.GetProcessLatencyPercentile(50) <= self.recorder.GetProcessLatencyPercentile(99)
+
+    def test_recording_is_written_in_little_endian_order(self):
+        assert self.recorder.StartRecording(self.recordingPath)
+        self.pipelineManager.SetInteractionRecorder(self.recorder)
+        self.sendEvents(2)
+        self.recorder.StopRecording()
+
+        with open(self.recordingPath, "rb") as f:
+            content = f.read()
+
+        assert content[:4] == b"LDMI"
+        assert struct.unpack_from("<I", content, 4)[0] == 2
+        _, eventType, _, x, y = struct.unpack_from("<dIiii", content, 8)
+        assert eventType == vtkCommand.MouseMoveEvent
+        assert (x, y) == (0, 0)
+
+    def test_replayed_events_carry_the_input_renderer(self):
+        assert self.recorder.StartRecording(self.recordingPath)
+        self.pipelineManager.SetInteractionRecorder(self.recorder)
+        self.sendEvents(1)
+        self.recorder.StopRecording()
+        self.pipelineManager.SetInteractionRecorder(None)
+
+        self.pipelines[0].mockCanProcess.return_value = (True, 0)
+        self.pipelines[0].mockProcess.return_value = True
+
+        renderer = vtkRenderer()
+        assert self.recorder.Replay(self.recordingPath, self.pipelineManager, renderer)
+        replayed = self.pipelines[0].mockProcess.call_args[0][0]
+        assert replayed.GetRenderer() == renderer
+
+    def test_replay_of_invalid_file_fails(self):
+        with open(self.recordingPath, "wb") as f:
+            f.write(b"invalid")
+        assert not self.recorder.Replay(self.recordingPath, self.pipelineManager)
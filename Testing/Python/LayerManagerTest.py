@@ -129,6 +129,15 @@ class LayerManagerTest(ScriptedLoadableModuleTest):
         assert renderers[1].GetActiveCamera() == customCam
         assert renderers[2].GetActiveCamera() == self.defaultCamera
 
+    def test_known_default_camera_clipping_range_is_used_without_bounds(self):
+        customCam = vtkCamera()
+        for layer, camera in [(1, None), (2, customCam)]:
+            self.layerManager.AddPipeline(Pipeline(layer, camera))
+
+        self.layerManager.ResetCameraClippingRange([10, 20])
+        assert self.defaultCamera.GetClippingRange() == (10, 20)
+        assert customCam.GetClippingRange() != (10, 20)
+
     def test_created_renderers_are_set_to_not_interactive(self):
         pipelines = [Pipeline(1) for _ in range(5)]
         for pipeline in pipelines:
@@ -0,0 +1,84 @@
+import time
+
+from slicer import vtkObjectEventObserver
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkCommand, vtkObject
+
+
+class ObjectEventObserverTest(ScriptedLoadableModuleTest):
+    def test_observes_each_event_once_and_the_object_deletion(self):
+        observer = vtkObjectEventObserver()
+        observed = vtkObject()
+        assert observer.AddEventObserver(observed, vtkCommand.ModifiedEvent)
+        assert not observer.AddEventObserver(observed, vtkCommand.ModifiedEvent)
+        assert observer.AddEventObserver(observed, vtkCommand.UserEvent)
+
+        assert observer.GetNumberOfObservedObjects() == 1
+        assert observer.GetNumberOfObservers() == 3
+        assert observed.HasObserver(vtkCommand.DeleteEvent)
+
+    def test_deleted_objects_are_removed_from_the_table(self):
+        observer = vtkObjectEventObserver()
+        observed = vtkObject()
+        observer.UpdateObserver(None, observed, [vtkCommand.ModifiedEvent, vtkCommand.UserEvent])
+        observer.SetCoalescing(True)
+        observed.Modified()
+        assert observer.GetNumberOfPendingEvents() == 1
+
+        del observed
+        assert observer.GetNumberOfObservedObjects() == 0
+        assert observer.GetNumberOfObservers() == 0
+        assert observer.GetNumberOfPendingEvents() == 0
+
+    def test_removing_the_last_event_stops_observing_the_object_deletion(self):
+        observer = vtkObjectEventObserver()
+        observed = vtkObject()
+        observer.AddEventObserver(observed, vtkCommand.ModifiedEvent)
+        observer.AddEventObserver(observed, vtkCommand.UserEvent)
+
+        observer.RemoveEventObserver(observed, vtkCommand.ModifiedEvent)
+        assert observer.GetNumberOfObservers() == 2
+        assert not observed.HasObserver(vtkCommand.ModifiedEvent)
+
+        observer.RemoveEventObserver(observed, vtkCommand.UserEvent)
+        assert observer.GetNumberOfObservers() == 0
+        assert not observed.HasObserver(vtkCommand.DeleteEvent)
+
+    def test_observed_delete_event_is_kept_until_removed(self):
+        observer = vtkObjectEventObserver()
+        observed = vtkObject()
+        assert observer.AddEventObserver(observed, vtkCommand.DeleteEvent)
+        assert not observer.AddEventObserver(observed, vtkCommand.DeleteEvent)
+        assert observer.GetNumberOfObservers() == 1
+
+        observer.RemoveEventObserver(observed, vtkCommand.DeleteEvent)
+        assert observer.GetNumberOfObservedObjects() == 0
+        assert not observed.HasObserver(vtkCommand.DeleteEvent)
+
+    def test_benchmark_dispatch_rate_and_memory(self):
+        nObservers, nEvents, nObjects = 1000, 1000, 10000
+
+        # Dispatch rate of one object observed by many observers to amortize the python call of each event
+        observed = vtkObject()
+        observers = [vtkObjectEventObserver() for _ in range(nObservers)]
+        for observer in observers:
+            observer.AddEventObserver(observed, vtkCommand.ModifiedEvent)
+
+        start = time.perf_counter()
+        for _ in range(nEvents):
+            observed.Modified()
+        eventsPerSecond = (nObservers * nEvents) / (time.perf_counter() - start)
+
+        # Table memory of one observer observing many objects
+        observer = vtkObjectEventObserver()
+        memorySize = observer.GetMemorySize()
+        objects = [vtkObject() for _ in range(nObjects)]
+        for obj in objects:
+            observer.AddEventObserver(obj, vtkCommand.ModifiedEvent)
+        bytesPerObject = (observer.GetMemorySize() - memorySize) / nObjects
+
+        print(f"Object event observer: {eventsPerSecond:.3g} events / s, {bytesPerObject:.1f} bytes / observed object")
+        assert observer.GetNumberOfObservedObjects() == nObjects
+
+        del objects
+        assert observer.GetNumberOfObservedObjects() == 0
@@ -0,0 +1,214 @@
+import time
+
+import slicer
+from LayerDMManagerLib import vtkMRMLLayerDMScriptedPipeline
+from slicer import vtkMRMLLayerDMObserverHub, vtkMRMLLayerDMPipelineI, vtkMRMLLayerDMPipelineManager
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import vtkCommand, vtkObject, vtkRenderWindow
+
+
+class CountingPipeline(vtkMRMLLayerDMScriptedPipeline):
+    def __init__(self):
+        super().__init__()
+        self.events = []
+        self.callData = []
+        self.onUpdate = None
+
+    def OnUpdate(self, obj, eventId, callData) -> None:
+        self.events.append(eventId)
+        self.callData.append(callData)
+        if self.onUpdate:
+            self.onUpdate()
+
+
+class ObserverHubTest(ScriptedLoadableModuleTest):
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.hub = vtkMRMLLayerDMObserverHub.GetInstance()
+
+    def tearDown(self):
+        self.hub.SetCoalescing(False)
+        self.hub.SetEventCoalesced(vtkCommand.UserEvent, True)
+
+    def test_pipelines_share_one_observer_per_object_event(self):
+        observed = vtkObject()
+        nObservers = self.hub.GetNumberOfObservers()
+        nSubscriptions = self.hub.GetNumberOfSubscriptions()
+
+        pipelines = [CountingPipeline() for _ in range(10)]
+        for pipeline in pipelines:
+            assert pipeline.UpdateObserver(None, observed, [vtkCommand.ModifiedEvent, vtkCommand.UserEvent])
+
+        # One observer per event and one DeleteEvent observer
+        assert self.hub.GetNumberOfObservers() == nObservers + 3
+        assert self.hub.GetNumberOfSubscriptions() == nSubscriptions + 20
+
+        observed.Modified()
+        observed.InvokeEvent(vtkCommand.UserEvent)
+        for pipeline in pipelines:
+            assert pipeline.events == [vtkCommand.ModifiedEvent, vtkCommand.UserEvent]
+
+        for pipeline in pipelines:
+            assert pipeline.UpdateObserver(observed, None)
+        assert self.hub.GetNumberOfObservers() == nObservers
+        assert self.hub.GetNumberOfSubscriptions() == nSubscriptions
+
+    def test_update_observer_moves_subscription_to_new_object(self):
+        prevObserved = vtkObject()
+        observed = vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.UpdateObserver(None, prevObserved)
+        assert not pipeline.UpdateObserver(prevObserved, prevObserved)
+        assert pipeline.UpdateObserver(prevObserved, observed)
+
+        prevObserved.Modified()
+        assert pipeline.events == []
+        observed.Modified()
+        assert pipeline.events == [vtkCommand.ModifiedEvent]
+
+    def test_subscribers_removed_during_dispatch_are_not_notified(self):
+        observed = vtkObject()
+        first, second = CountingPipeline(), CountingPipeline()
+        first.UpdateObserver(None, observed)
+        second.UpdateObserver(None, observed)
+        first.onUpdate = lambda: second.UpdateObserver(observed, None)
+
+        nSubscriptions = self.hub.GetNumberOfSubscriptions()
+        observed.Modified()
+        assert first.events == [vtkCommand.ModifiedEvent]
+        assert second.events == []
+        assert self.hub.GetNumberOfSubscriptions() == nSubscriptions - 1
+
+    def test_deleted_objects_and_pipelines_are_unsubscribed(self):
+        nObjects = self.hub.GetNumberOfObservedObjects()
+        nSubscriptions = self.hub.GetNumberOfSubscriptions()
+
+        observed = vtkObject()
+        pipeline = vtkMRMLLayerDMPipelineI()
+        pipeline.UpdateObserver(None, observed)
+        assert self.hub.GetNumberOfObservedObjects() == nObjects + 1
+        del observed
+        assert self.hub.GetNumberOfObservedObjects() == nObjects
+        assert self.hub.GetNumberOfSubscriptions() == nSubscriptions
+
+        observed = vtkObject()
+        pipeline.UpdateObserver(None, observed)
+        del pipeline
+        assert self.hub.GetNumberOfObservedObjects() == nObjects
+        assert self.hub.GetNumberOfSubscriptions() == nSubscriptions
+
+    def test_coalesced_events_are_delivered_once_on_flush(self):
+        observed = vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.UpdateObserver(None, observed, [vtkCommand.ModifiedEvent, vtkCommand.UserEvent])
+        self.hub.SetCoalescing(True)
+
+        for _ in range(5):
+            observed.Modified()
+            observed.InvokeEvent(vtkCommand.UserEvent)
+        assert pipeline.events == []
+        assert self.hub.HasPendingEvents()
+
+        self.hub.Flush()
+        assert pipeline.events == [vtkCommand.ModifiedEvent, vtkCommand.UserEvent]
+        assert pipeline.callData == [None, None]
+        assert not self.hub.HasPendingEvents()
+
+    def test_disabling_coalescing_flushes_pending_events(self):
+        observed = vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.UpdateObserver(None, observed)
+        self.hub.SetCoalescing(True)
+
+        observed.Modified()
+        self.hub.SetCoalescing(False)
+        assert pipeline.events == [vtkCommand.ModifiedEvent]
+
+        observed.Modified()
+        assert pipeline.events == [vtkCommand.ModifiedEvent, vtkCommand.ModifiedEvent]
+
+    def test_opted_out_events_are_delivered_immediately(self):
+        observed = vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.UpdateObserver(None, observed, [vtkCommand.ModifiedEvent, vtkCommand.UserEvent])
+        self.hub.SetCoalescing(True)
+        self.hub.SetEventCoalesced(vtkCommand.UserEvent, False)
+        assert not self.hub.IsEventCoalesced(vtkCommand.UserEvent)
+        assert not self.hub.IsEventCoalesced(vtkCommand.DeleteEvent)
+
+        observed.Modified()
+        observed.InvokeEvent(vtkCommand.UserEvent)
+        assert pipeline.events == [vtkCommand.UserEvent]
+
+        self.hub.Flush()
+        assert pipeline.events == [vtkCommand.UserEvent, vtkCommand.ModifiedEvent]
+
+    def test_pending_events_of_deleted_objects_and_unsubscribed_pipelines_are_discarded(self):
+        deleted, unsubscribed = vtkObject(), vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.UpdateObserver(None, deleted)
+        pipeline.UpdateObserver(None, unsubscribed)
+        self.hub.SetCoalescing(True)
+
+        deleted.Modified()
+        unsubscribed.Modified()
+        del deleted
+        pipeline.UpdateObserver(unsubscribed, None)
+
+        self.hub.Flush()
+        assert pipeline.events == []
+
+    def test_pipeline_manager_flushes_coalesced_events_before_render(self):
+        renderWindow = vtkRenderWindow()
+        renderRequests = []
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetRenderWindow(renderWindow)
+        pipelineManager.SetRequestRender(lambda: renderRequests.append(True))
+
+        observed = vtkObject()
+        pipeline = CountingPipeline()
+        pipeline.SetPipelineManager(pipelineManager)
+        pipeline.UpdateObserver(None, observed)
+        pipeline.onUpdate = pipeline.RequestRender
+        self.hub.SetCoalescing(True)
+
+        for _ in range(5):
+            observed.Modified()
+        assert pipeline.events == []
+        assert len(renderRequests) == 1
+
+        # Render requested by the pipeline during the flush are part of the starting render
+        renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        assert pipeline.events == [vtkCommand.ModifiedEvent]
+        assert len(renderRequests) == 1
+
+        observed.Modified()
+        assert len(renderRequests) == 2
+
+    def test_benchmark_memory_and_dispatch_time(self):
+        nViews, nPipelinesPerView, nEvents = 4, 250, 1000
+        viewNode = slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode")
+        nObservers = self.hub.GetNumberOfObservers()
+        memorySize = self.hub.GetMemorySize()
+
+        pipelines = [vtkMRMLLayerDMPipelineI() for _ in range(nViews * nPipelinesPerView)]
+        for pipeline in pipelines:
+            pipeline.SetViewNode(viewNode)
+
+        # The view node carries a single observer (and its DeleteEvent observer) whatever the number of pipelines
+        assert self.hub.GetNumberOfObservers() == nObservers + 2
+        subscriptionMemory = (self.hub.GetMemorySize() - memorySize) / len(pipelines)
+
+        start = time.perf_counter()
+        for _ in range(nEvents):
+            viewNode.Modified()
+        dispatchTime = (time.perf_counter() - start) / (nEvents * len(pipelines))
+
+        print(
+            f"Observer hub: {len(pipelines)} pipelines, {self.hub.GetNumberOfObservers() - nObservers} view node observers, "
+            f"{subscriptionMemory:.1f} bytes / subscription, {dispatchTime * 1e9:.1f} ns / dispatched subscription"
+        )
+
+        for pipeline in pipelines:
+            pipeline.SetViewNode(None)
+        assert self.hub.GetNumberOfObservers() == nObservers
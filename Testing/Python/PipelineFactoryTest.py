@@ -106,3 +106,39 @@ class PipelineFactoryTest(ScriptedLoadableModuleTest):
 
         self.factory.CreatePipeline(viewNode, node)
         mock.assert_called_once_with(viewNode, node, instance)
+
+    def test_create_pipelines_calls_batch_callback_once_with_filtered_nodes(self):
+        modelNodes = [slicer.vtkMRMLModelNode() for _ in range(3)]
+        nodes = [vtkMRMLCameraNode(), *modelNodes]
+        instances = [vtkMRMLLayerDMPipelineI() for _ in modelNodes]
+
+        creator = vtkMRMLLayerDMPipelineScriptedCreator()
+        creator.AddNodeClassName("vtkMRMLModelNode")
+        batchCallback = MagicMock(return_value=[instances[0], None, instances[2]])
+        creator.SetPythonBatchCallback(batchCallback)
+        self.factory.AddPipelineCreator(creator)
+
+        viewNode = vtkMRMLViewNode()
+        pipelines = self.factory.CreatePipelines(viewNode, nodes)
+        batchCallback.assert_called_once_with(viewNode, modelNodes)
+        assert pipelines[0] is None
+        assert pipelines[1] == instances[0]
+        assert pipelines[2] is None
+        assert pipelines[3] == instances[2]
+
+    def test_create_pipelines_passes_unhandled_nodes_to_next_creator(self):
+        nodes = [vtkMRMLCameraNode(), vtkMRMLCameraNode()]
+        instance = vtkMRMLLayerDMPipelineI()
+
+        c1 = vtkMRMLLayerDMPipelineScriptedCreator()
+        c1.SetPythonBatchCallback(lambda _view, batch: [instance if node == nodes[0] else None for node in batch])
+        self.factory.AddPipelineCreator(c1)
+
+        fallback = MagicMock(return_value=instance)
+        c2 = vtkMRMLLayerDMPipelineScriptedCreator()
+        c2.SetPythonCallback(fallback)
+        self.factory.AddPipelineCreator(c2)
+
+        pipelines = self.factory.CreatePipelines(None, nodes)
+        assert pipelines == [instance, instance]
+        fallback.assert_called_once_with(None, nodes[1])
@@ -1,7 +1,9 @@
+import time
 from unittest.mock import MagicMock
 
 import slicer
 from slicer import (
+    vtkMRMLLayerDMCameraSynchronizer,
     vtkMRMLLayerDMPipelineCreatorI,
     vtkMRMLLayerDMPipelineFactory,
     vtkMRMLLayerDMPipelineI,
@@ -10,12 +12,13 @@ from slicer import (
     vtkMRMLAbstractViewNode,
     vtkMRMLInteractionEventData,
     vtkMRMLMarkupsFiducialNode,
+    vtkMRMLModelDisplayNode,
     vtkMRMLModelNode,
     vtkMRMLScalarVolumeNode,
     vtkMRMLViewNode,
 )
 from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
-from vtk import vtkRenderWindow, reference as ref, vtkCommand
+from vtk import vtkCamera, vtkRenderWindow, reference as ref, vtkCommand
 from MockPipeline import MockPipeline
 
 
@@ -251,3 +254,382 @@ class PipelineManagerTest(ScriptedLoadableModuleTest):
 
         self.pipelineManager.RemoveNode(modelNode)
         mock.assert_called_once()
+
+    def test_request_render_releases_the_gil_for_background_threads(self):
+        import sys
+        import threading
+        from vtk import vtkActor, vtkPolyDataMapper, vtkRenderer, vtkSphereSource
+
+        # The clipping range reset of the render request executes this C++ source, without python callback
+        renderer = vtkRenderer()
+        self.renderWindow.AddRenderer(renderer)
+        self.pipelineManager.SetRenderer(renderer)
+        sphere = vtkSphereSource()
+        sphere.SetThetaResolution(1000)
+        sphere.SetPhiResolution(1000)
+        mapper = vtkPolyDataMapper()
+        mapper.SetInputConnection(sphere.GetOutputPort())
+        actor = vtkActor()
+        actor.SetMapper(mapper)
+        renderer.AddActor(actor)
+
+        isRenderStarted = threading.Event()
+        backgroundDoneTime = []
+
+        def backgroundWork():
+            isRenderStarted.wait()
+            sum(range(1000))
+            backgroundDoneTime.append(time.perf_counter())
+
+        # Without GIL release, the background thread can only run once the render request returned
+        prevSwitchInterval = sys.getswitchinterval()
+        sys.setswitchinterval(10)
+        thread = threading.Thread(target=backgroundWork)
+        thread.start()
+        try:
+            isRenderStarted.set()
+            self.pipelineManager.RequestRender()
+            renderEndTime = time.perf_counter()
+        finally:
+            thread.join()
+            sys.setswitchinterval(prevSwitchInterval)
+
+        assert backgroundDoneTime[0] < renderEndTime
+
+    def test_default_camera_changes_are_classified_and_filtered_by_pipeline_mask(self):
+        class CameraPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.cameraChanges = []
+
+            def OnDefaultCameraChanged(self, camera, cameraChanges):
+                self.cameraChanges.append(cameraChanges)
+
+        allChanges = self.triggerMockPipelineCreation(CameraPipeline())
+        zoomOnly = self.triggerMockPipelineCreation(CameraPipeline())
+        zoomOnly.SetDefaultCameraChangeMask(vtkMRMLLayerDMPipelineI.CameraProjectionChange)
+
+        camera = self.pipelineManager.GetDefaultCamera()
+        camera.SetPosition(0, 0, 10)
+        camera.SetFocalPoint(0, 0, 0)
+        camera.SetViewUp(0, 1, 0)
+        allChanges.cameraChanges.clear()
+        zoomOnly.cameraChanges.clear()
+
+        camera.Zoom(2)
+        assert allChanges.cameraChanges[-1] & vtkMRMLLayerDMPipelineI.CameraProjectionChange
+        assert not allChanges.cameraChanges[-1] & vtkMRMLLayerDMPipelineI.CameraOrientationChange
+        assert len(zoomOnly.cameraChanges) == 1
+
+        camera.Roll(30)
+        assert allChanges.cameraChanges[-1] & vtkMRMLLayerDMPipelineI.CameraOrientationChange
+        assert not allChanges.cameraChanges[-1] & vtkMRMLLayerDMPipelineI.CameraProjectionChange
+        assert len(zoomOnly.cameraChanges) == 1
+
+        # Modifications without camera change are not forwarded
+        nChanges = len(allChanges.cameraChanges)
+        camera.Modified()
+        assert len(allChanges.cameraChanges) == nChanges
+
+    def test_one_argument_default_camera_modified_overrides_are_still_called(self):
+        class LegacyCameraPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.cameras = []
+
+            def OnDefaultCameraModified(self, camera):
+                self.cameras.append(camera)
+
+        pipeline = self.triggerMockPipelineCreation(LegacyCameraPipeline())
+        pipeline.cameras.clear()
+
+        camera = self.pipelineManager.GetDefaultCamera()
+        camera.Zoom(2)
+        assert pipeline.cameras == [camera]
+
+    def test_shared_camera_sync_warns_for_pipelines_with_own_camera(self):
+        class OwnCameraPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.camera = vtkCamera()
+
+            def GetCamera(self):
+                return self.camera
+
+        warnings = []
+        self.pipelineManager.AddObserver(vtkCommand.WarningEvent, lambda *_: warnings.append(True))
+        self.triggerMockPipelineCreation(MockPipeline())
+        self.pipelineManager.SetCameraSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncSharedCamera)
+        assert warnings == []
+
+        self.triggerMockPipelineCreation(OwnCameraPipeline())
+        assert len(warnings) == 1
+
+        self.pipelineManager.SetCameraSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncChangedParameters)
+        self.pipelineManager.SetCameraSyncMode(vtkMRMLLayerDMCameraSynchronizer.SyncSharedCamera)
+        assert len(warnings) == 2
+
+    def test_before_render_is_called_once_per_frame_for_view_dependent_pipelines(self):
+        class ViewDependentPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.frames = []
+
+            def OnBeforeRender(self, context):
+                self.frames.append((context.GetFrameIndex(), context.GetCameraChanges()))
+
+        zoomDependent = self.triggerMockPipelineCreation(ViewDependentPipeline())
+        zoomDependent.SetViewDependencyMask(vtkMRMLLayerDMPipelineI.CameraProjectionChange)
+        independent = self.triggerMockPipelineCreation(ViewDependentPipeline())
+
+        camera = self.pipelineManager.GetDefaultCamera()
+        camera.SetPosition(0, 0, 10)
+        camera.SetFocalPoint(0, 0, 0)
+        camera.SetViewUp(0, 1, 0)
+        self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        zoomDependent.frames.clear()
+
+        # Camera modifications between two frames are notified once
+        for _ in range(3):
+            camera.Zoom(1.5)
+        self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        assert len(zoomDependent.frames) == 1
+        assert zoomDependent.frames[0][1] & vtkMRMLLayerDMPipelineI.CameraProjectionChange
+        assert independent.frames == []
+
+        # Frames without changes of the view dependencies are not notified
+        camera.Roll(30)
+        self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        assert len(zoomDependent.frames) == 1
+
+        independent.RequestBeforeRender()
+        self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+        assert len(independent.frames) == 1
+        assert independent.frames[0][0] > zoomDependent.frames[0][0]
+
+    def test_async_update_is_computed_on_worker_and_applied_on_main_thread(self):
+        import threading
+
+        class AsyncPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.computeThreads = []
+                self.applied = []
+
+            def ComputeUpdateAsync(self):
+                self.computeThreads.append(threading.get_ident())
+                return "result"
+
+            def ApplyUpdate(self, result):
+                self.applied.append((threading.get_ident(), result))
+
+        renderMock = MagicMock()
+        self.pipelineManager.SetRequestRender(renderMock)
+
+        pipeline = self.triggerMockPipelineCreation(AsyncPipeline())
+        assert pipeline.IsUpdateAsync()
+        self.pipelineManager.WaitForAsyncUpdates()
+
+        mainThread = threading.get_ident()
+        assert self.pipelineManager.GetNumberOfPendingAsyncUpdates() == 0
+        assert len(pipeline.computeThreads) == 1
+        assert pipeline.computeThreads[0] != mainThread
+        assert pipeline.applied == [(mainThread, "result")]
+        renderMock.assert_called()
+
+    def test_superseded_async_update_only_applies_latest_result(self):
+        import threading
+
+        class BlockingAsyncPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.isReleased = threading.Event()
+                self.nComputes = 0
+                self.wasCancelled = []
+                self.applied = []
+
+            def ComputeUpdateAsync(self):
+                self.nComputes += 1
+                result = self.nComputes
+                self.isReleased.wait()
+                self.wasCancelled.append(self.IsAsyncUpdateCancelled())
+                return result
+
+            def ApplyUpdate(self, result):
+                self.applied.append(result)
+
+        pipeline = self.triggerMockPipelineCreation(BlockingAsyncPipeline())
+        pipeline.RequestAsyncUpdate()
+        pipeline.RequestAsyncUpdate()
+        assert self.pipelineManager.GetNumberOfPendingAsyncUpdates() == 1
+
+        pipeline.isReleased.set()
+        self.pipelineManager.WaitForAsyncUpdates()
+
+        # Superseding requests are coalesced into a single rerun
+        assert pipeline.nComputes == 2
+        assert pipeline.wasCancelled == [True, False]
+        assert pipeline.applied == [2]
+
+    def test_async_update_of_removed_pipeline_is_discarded(self):
+        import threading
+
+        class BlockingAsyncPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.isReleased = threading.Event()
+                self.applied = []
+
+            def ComputeUpdateAsync(self):
+                self.isReleased.wait()
+                return "result"
+
+            def ApplyUpdate(self, result):
+                self.applied.append(result)
+
+        pipeline = self.triggerMockPipelineCreation(BlockingAsyncPipeline())
+        self.pipelineManager.RemoveNode(pipeline.GetDisplayNode())
+
+        pipeline.isReleased.set()
+        self.pipelineManager.WaitForAsyncUpdates()
+        assert pipeline.applied == []
+
+    def test_failed_async_update_is_not_applied(self):
+        class FailingAsyncPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.applied = []
+
+            def ComputeUpdateAsync(self):
+                raise RuntimeError("Expected test failure")
+
+            def ApplyUpdate(self, result):
+                self.applied.append(result)
+
+        pipeline = self.triggerMockPipelineCreation(FailingAsyncPipeline())
+        self.pipelineManager.WaitForAsyncUpdates()
+        assert self.pipelineManager.GetNumberOfPendingAsyncUpdates() == 0
+        assert pipeline.applied == []
+
+    def test_pipeline_manager_deletion_waits_for_running_async_update(self):
+        import threading
+
+        class BlockingAsyncPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.isReleased = threading.Event()
+                self.isComputed = False
+                self.applied = []
+
+            def ComputeUpdateAsync(self):
+                self.isReleased.wait()
+                self.isComputed = True
+                return "result"
+
+            def ApplyUpdate(self, result):
+                self.applied.append(result)
+
+        pipeline = self.triggerMockPipelineCreation(BlockingAsyncPipeline())
+        releaseTimer = threading.Timer(0.05, pipeline.isReleased.set)
+        releaseTimer.start()
+
+        # The worker is joined with the GIL released before the pipeline manager is deleted
+        self.pipelineManager = None
+        releaseTimer.join()
+        assert pipeline.isComputed
+        assert pipeline.applied == []
+
+    def test_scheduled_updates_are_processed_within_the_frame_budget_visible_first(self):
+        class SlowPipeline(MockPipeline):
+            def __init__(self, updated):
+                super().__init__()
+                self.updated = updated
+
+            def UpdatePipeline(self):
+                time.sleep(0.005)
+                self.updated.append(self)
+
+        settledMock = MagicMock()
+        self.pipelineManager.AddObserver(vtkMRMLLayerDMPipelineManager.UpdatesSettledEvent, settledMock)
+        self.pipelineManager.SetUpdateBudget(8)
+
+        updated = []
+        pipelines = {True: [], False: []}
+        for isVisible in [False, True, False, True]:
+            displayNode = vtkMRMLModelDisplayNode()
+            displayNode.SetVisibility(isVisible)
+            self.nextMock = SlowPipeline(updated)
+            assert self.pipelineManager.AddNode(displayNode)
+            pipelines[isVisible].append(self.nextMock)
+
+        # Updates are scheduled instead of being applied on pipeline creation
+        assert updated == []
+        assert self.pipelineManager.GetNumberOfScheduledUpdates() == 4
+
+        nFrames = 0
+        while self.pipelineManager.GetNumberOfScheduledUpdates():
+            settledMock.assert_not_called()
+            self.renderWindow.InvokeEvent(vtkCommand.StartEvent)
+            nFrames += 1
+
+        # At most two 5 ms updates fit in the 8 ms budget of each frame
+        assert nFrames >= 2
+        assert updated == pipelines[True] + pipelines[False]
+        settledMock.assert_called_once()
+
+        # Requests of scheduled pipelines are coalesced
+        pipelines[True][0].RequestUpdate()
+        pipelines[True][0].RequestUpdate()
+        assert self.pipelineManager.GetNumberOfScheduledUpdates() == 1
+        self.pipelineManager.FlushScheduledUpdates()
+        assert self.pipelineManager.GetNumberOfScheduledUpdates() == 0
+        assert settledMock.call_count == 2
+
+    def test_renderer_changes_update_the_pipelines_immediately_with_an_update_budget(self):
+        class CountingPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__(layer=1)
+                self.nUpdates = 0
+
+            def UpdatePipeline(self):
+                self.nUpdates += 1
+
+        self.pipelineManager.SetUpdateBudget(8)
+
+        # The renderer of the new pipeline is part of its scheduled update
+        pipeline = self.triggerMockPipelineCreation(CountingPipeline())
+        assert pipeline.nUpdates == 0
+        self.pipelineManager.FlushScheduledUpdates()
+        assert pipeline.nUpdates == 1
+
+        pipeline.layer = 2
+        self.pipelineManager.UpdatePipelineLayer(pipeline)
+        assert pipeline.nUpdates == 2
+        assert self.pipelineManager.GetNumberOfScheduledUpdates() == 0
+
+    def test_updates_settled_event_is_invoked_once_per_batch_of_immediate_updates(self):
+        class CountingPipeline(MockPipeline):
+            def __init__(self):
+                super().__init__()
+                self.nUpdates = 0
+
+            def UpdatePipeline(self):
+                self.nUpdates += 1
+
+        pipelines = []
+        settledUpdates = []
+        self.pipelineManager.AddObserver(
+            vtkMRMLLayerDMPipelineManager.UpdatesSettledEvent,
+            lambda *_: settledUpdates.append([pipeline.nUpdates for pipeline in pipelines]),
+        )
+
+        # Each pipeline creation is a batch
+        created = [self.triggerMockPipelineCreation(CountingPipeline()) for _ in range(3)]
+        assert len(settledUpdates) == 3
+        pipelines.extend(created)
+        settledUpdates.clear()
+
+        # The event is invoked once all the pipelines of the batch are up to date
+        self.pipelineManager.UpdateAllPipelines()
+        assert settledUpdates == [[2, 2, 2]]
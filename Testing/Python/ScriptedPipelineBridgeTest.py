@@ -0,0 +1,380 @@
+from unittest.mock import MagicMock
+
+import slicer
+from LayerDMManagerLib import vtkMRMLLayerDMScriptedPipeline
+from LayerDMManagerLib.vtkMRMLLayerDMScriptedPipeline import layerDMDefault
+from slicer import (
+    vtkMRMLInteractionEventData,
+    vtkMRMLLayerDMLayerManager,
+    vtkMRMLLayerDMPipelineFactory,
+    vtkMRMLLayerDMPipelineManager,
+    vtkMRMLLayerDMPipelineScriptedCreator,
+    vtkMRMLModelDisplayNode,
+)
+from slicer.ScriptedLoadableModule import ScriptedLoadableModuleTest
+from vtk import reference, vtkCamera, vtkRenderer, vtkRenderWindow
+
+
+class Pipeline(vtkMRMLLayerDMScriptedPipeline):
+    def __init__(self):
+        super().__init__()
+        self.mockUpdatePipeline = MagicMock()
+
+    def GetRenderLayer(self) -> int:
+        return 3
+
+    def UpdatePipeline(self) -> None:
+        self.mockUpdatePipeline()
+
+
+class ReferencePipeline(vtkMRMLLayerDMScriptedPipeline):
+    def GetRenderLayer(self) -> int:
+        return 4
+
+
+class DefaultPipeline(vtkMRMLLayerDMScriptedPipeline):
+    """
+    Pipeline whose hooks are flagged as default implementations and record their python calls.
+    """
+
+    def __init__(self):
+        super().__init__()
+        self.pythonCalls = []
+
+    @layerDMDefault
+    def GetRenderLayer(self) -> int:
+        self.pythonCalls.append("GetRenderLayer")
+        return 5
+
+    @layerDMDefault
+    def UpdatePipeline(self) -> None:
+        self.pythonCalls.append("UpdatePipeline")
+
+    @layerDMDefault
+    def CanProcessInteractionEvent(self, eventData):
+        self.pythonCalls.append("CanProcessInteractionEvent")
+        return True, 0.0
+
+
+class ScriptedPipelineBridgeTest(ScriptedLoadableModuleTest):
+    """
+    Methods called from python resolve to the python implementation directly.
+    The bridge delegation is tested through the C++ callers (layer manager and pipeline manager).
+    """
+
+    def setUp(self):
+        slicer.mrmlScene.Clear(0)
+        self.renderWindow = vtkRenderWindow()
+        self.renderWindow.AddRenderer(vtkRenderer())
+        self.layerManager = vtkMRMLLayerDMLayerManager()
+        self.layerManager.SetRenderWindow(self.renderWindow)
+        self.layerManager.SetDefaultCamera(vtkCamera())
+
+        # Pipeline in layer 4 used as a reference for the render layers returned by the tested pipelines
+        self.referencePipeline = ReferencePipeline()
+        self.layerManager.AddPipeline(self.referencePipeline)
+
+    def isBelowReferenceLayer(self, pipeline) -> bool:
+        return pipeline.GetRenderer().GetLayer() < self.referencePipeline.GetRenderer().GetLayer()
+
+    @staticmethod
+    def createPipelineManager(pipeline, displayNode=None):
+        """
+        Returns a pipeline manager managing the input pipeline for the input display node.
+        """
+        factory = vtkMRMLLayerDMPipelineFactory()
+        creator = vtkMRMLLayerDMPipelineScriptedCreator()
+        creator.SetPythonCallback(lambda *_: pipeline)
+        factory.AddPipelineCreator(creator)
+
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetViewNode(slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode"))
+        pipelineManager.SetFactory(factory)
+        assert pipelineManager.AddNode(displayNode or vtkMRMLModelDisplayNode())
+        return pipelineManager
+
+    def test_overridden_methods_are_delegated_to_python(self):
+        pipeline = Pipeline()
+        self.layerManager.AddPipeline(pipeline)
+        assert self.isBelowReferenceLayer(pipeline)
+
+        pipelineManager = self.createPipelineManager(pipeline)
+        pipeline.mockUpdatePipeline.reset_mock()
+        pipelineManager.UpdateAllPipelines()
+        pipeline.mockUpdatePipeline.assert_called_once()
+
+    def test_default_methods_use_cpp_implementation(self):
+        defaultPipeline = DefaultPipeline()
+        overriddenPipeline = Pipeline()
+        pipelines = [defaultPipeline, overriddenPipeline]
+        for pipeline in pipelines:
+            pipeline.SetProfilingEnabled(True)
+
+        # The layer manager queries the render layer and the camera, C++ default layer 0 is below the python layer 3
+        for pipeline in pipelines:
+            self.layerManager.AddPipeline(pipeline)
+        assert defaultPipeline.GetRenderer().GetLayer() < overriddenPipeline.GetRenderer().GetLayer()
+
+        # The pipeline manager calls the set methods, the updates and the interaction methods
+        for pipeline in pipelines:
+            pipelineManager = self.createPipelineManager(pipeline)
+            pipelineManager.UpdateAllPipelines()
+            assert not pipelineManager.CanProcessInteractionEvent(vtkMRMLInteractionEventData(), reference(0.0))
+
+        # Only the overridden methods enter python
+        assert not defaultPipeline.GetProfiledMethodNames()
+        assert defaultPipeline.pythonCalls == []
+        assert overriddenPipeline.GetProfilingCallCount("GetRenderLayer") > 0
+        assert overriddenPipeline.GetProfilingCallCount("UpdatePipeline") > 0
+        assert set(overriddenPipeline.GetProfiledMethodNames()) == {"GetRenderLayer", "UpdatePipeline"}
+
+    def test_default_set_methods_forward_to_superclass(self):
+        pipeline = vtkMRMLLayerDMScriptedPipeline()
+        displayNode = vtkMRMLModelDisplayNode()
+        pipelineManager = self.createPipelineManager(pipeline, displayNode)
+        assert pipeline.displayNode == displayNode
+        assert pipeline.viewNode == pipelineManager.GetViewNode()
+
+    def test_patched_methods_are_used_after_cache_invalidation(self):
+        pipeline = Pipeline()
+        pipeline.GetRenderLayer = MagicMock(return_value=5)
+        self.layerManager.AddPipeline(pipeline)
+        assert self.isBelowReferenceLayer(pipeline)
+        pipeline.GetRenderLayer.assert_not_called()
+
+        pipeline.InvalidatePythonMethodCache()
+        self.layerManager.UpdatePipelineLayer(pipeline)
+        assert not self.isBelowReferenceLayer(pipeline)
+        pipeline.GetRenderLayer.assert_called()
+
+    def test_static_render_layer_and_camera_are_returned_without_python_calls(self):
+        pipeline = Pipeline()
+        pipeline.GetRenderLayer = MagicMock(return_value=5)
+        pipeline.GetCamera = MagicMock(return_value=None)
+        pipeline.InvalidatePythonMethodCache()
+
+        camera = vtkCamera()
+        pipeline.SetStaticRenderLayer(2)
+        pipeline.SetStaticCamera(camera)
+        assert pipeline.HasStaticRenderLayer()
+        assert pipeline.HasStaticCamera()
+
+        self.layerManager.AddPipeline(pipeline)
+        assert self.isBelowReferenceLayer(pipeline)
+        assert pipeline.GetRenderer().GetActiveCamera() == camera
+        assert pipeline.GetRenderLayer.call_count == 0
+        assert pipeline.GetCamera.call_count == 0
+
+        pipeline.ClearStaticRenderLayer()
+        pipeline.ClearStaticCamera()
+        self.layerManager.UpdatePipelineLayer(pipeline)
+        assert not self.isBelowReferenceLayer(pipeline)
+        assert pipeline.GetRenderer().GetActiveCamera() != camera
+        assert pipeline.GetRenderLayer.call_count > 0
+
+    def test_static_render_layer_change_moves_pipeline_layer(self):
+        renderWindow = vtkRenderWindow()
+        renderWindow.AddRenderer(vtkRenderer())
+        layerManager = vtkMRMLLayerDMLayerManager()
+        layerManager.SetRenderWindow(renderWindow)
+        layerManager.SetDefaultCamera(vtkCamera())
+
+        pipeline = vtkMRMLLayerDMScriptedPipeline()
+        pipeline.SetStaticRenderLayer(1)
+        layerManager.AddPipeline(pipeline)
+        assert layerManager.GetNumberOfDistinctLayers() == 2
+
+        pipeline.SetStaticRenderLayer(0)
+        layerManager.UpdatePipelineLayer(pipeline)
+        assert layerManager.GetNumberOfDistinctLayers() == 1
+        assert pipeline.GetRenderer() == renderWindow.GetRenderers().GetFirstRenderer()
+
+    def test_profiling_counts_python_calls_only_when_enabled(self):
+        pipeline = Pipeline()
+        pipelineManager = self.createPipelineManager(pipeline)
+        pipelineManager.UpdateAllPipelines()
+        assert pipeline.getProfilingCounters() == {}
+
+        pipeline.SetProfilingEnabled(True)
+        for _ in range(3):
+            pipelineManager.UpdateAllPipelines()
+        self.layerManager.AddPipeline(pipeline)
+
+        counters = pipeline.getProfilingCounters()
+        assert set(counters.keys()) == {"UpdatePipeline", "GetRenderLayer"}
+        assert counters["UpdatePipeline"]["callCount"] == 3
+        assert counters["UpdatePipeline"]["gilAcquisitionCount"] == 3
+        assert counters["UpdatePipeline"]["totalTime"] >= counters["UpdatePipeline"]["maxTime"] >= 0
+        assert counters["UpdatePipeline"]["gilWaitTime"] >= 0
+
+        pipeline.ResetProfilingCounters()
+        assert pipeline.getProfilingCounters() == {}
+        assert pipeline.GetProfilingCallCount("InvalidMethod") == 0
+
+    def test_numpy_arrays_are_used_as_vtk_storage_without_copy(self):
+        import numpy as np
+        from LayerDMManagerLib.LayerDMNumpySupport import markModified, setArrayFromNumpy, setPointsFromNumpy
+
+        values = np.arange(12, dtype=np.float32).reshape(4, 3)
+        points = setPointsFromNumpy(values)
+        assert points.GetNumberOfPoints() == 4
+        assert points.GetPoint(1) == (3, 4, 5)
+
+        mTime = points.GetMTime()
+        values[1] = (7, 8, 9)
+        markModified(points)
+        assert points.GetPoint(1) == (7, 8, 9)
+        assert points.GetMTime() > mTime
+
+        scalars = setArrayFromNumpy(np.array([1, 2, 3], dtype=np.int32))
+        assert scalars.GetNumberOfTuples() == 3
+        assert scalars.GetValue(2) == 3
+
+    def test_numpy_buffer_is_kept_alive_by_array(self):
+        import gc
+        import numpy as np
+        from LayerDMManagerLib.LayerDMNumpySupport import setArrayFromNumpy
+
+        array = setArrayFromNumpy(np.full((1000, 2), 5.0))
+        gc.collect()
+        assert array.GetNumberOfComponents() == 2
+        assert array.GetTuple(999) == (5.0, 5.0)
+
+    def test_mismatching_buffer_type_is_rejected(self):
+        import numpy as np
+        from vtk import vtkFloatArray
+
+        assert not vtkMRMLLayerDMScriptedPipeline.SetArrayFromPythonBuffer(vtkFloatArray(), np.zeros(3, dtype=np.int64))
+
+    def test_read_only_buffer_is_rejected(self):
+        import numpy as np
+        from LayerDMManagerLib.LayerDMNumpySupport import setArrayFromNumpy
+        from vtk import vtkDoubleArray
+
+        values = np.zeros(3)
+        values.flags.writeable = False
+        assert not vtkMRMLLayerDMScriptedPipeline.SetArrayFromPythonBuffer(vtkDoubleArray(), values)
+
+        # The NumPy helper uses a writable copy instead
+        array = setArrayFromNumpy(values)
+        array.SetValue(0, 1.0)
+        assert values[0] == 0.0
+
+    def test_on_update_is_filtered_by_declared_events(self):
+        from vtk import vtkCommand, vtkObject
+
+        class ObservingPipeline(vtkMRMLLayerDMScriptedPipeline):
+            def __init__(self):
+                super().__init__()
+                self.mockOnUpdate = MagicMock()
+
+            def OnUpdate(self, obj, eventId, callData) -> None:
+                self.mockOnUpdate(obj, eventId, callData)
+
+        pipeline = ObservingPipeline()
+        observed = vtkObject()
+        pipeline.UpdateObserver(None, observed, [vtkCommand.ModifiedEvent, vtkCommand.UserEvent])
+        pipeline.AddOnUpdateEvent(vtkCommand.ModifiedEvent)
+
+        observed.InvokeEvent(vtkCommand.UserEvent)
+        pipeline.mockOnUpdate.assert_not_called()
+
+        observed.Modified()
+        pipeline.mockOnUpdate.assert_called_once_with(observed, vtkCommand.ModifiedEvent, None)
+
+        pipeline.ClearOnUpdateEvents()
+        observed.InvokeEvent(vtkCommand.UserEvent)
+        assert pipeline.mockOnUpdate.call_count == 2
+
+    def test_on_update_without_call_data_receives_none(self):
+        from vtk import vtkCommand, vtkObject
+
+        received = []
+
+        class ObservingPipeline(vtkMRMLLayerDMScriptedPipeline):
+            def OnUpdate(self, obj, eventId, callData) -> None:
+                received.append((obj, eventId, callData))
+
+        pipeline = ObservingPipeline()
+        observed = vtkObject()
+        pipeline.UpdateObserver(None, observed)
+
+        observed.InvokeEvent(vtkCommand.UserEvent, "callData")
+        assert len(received) == 1
+        assert received[0][:2] == (observed, vtkCommand.UserEvent)
+        assert received[0][2] is not None
+
+        received.clear()
+        pipeline.SetOnUpdateCallDataEnabled(False)
+        for _ in range(3):
+            observed.InvokeEvent(vtkCommand.UserEvent, "callData")
+        assert received == [(observed, vtkCommand.UserEvent, None)] * 3
+
+    def test_python_references_return_to_baseline_after_a_million_events(self):
+        import sys
+        from slicer import (
+            vtkMRMLInteractionEventData,
+            vtkMRMLLayerDMPipelineFactory,
+            vtkMRMLLayerDMPipelineManager,
+            vtkMRMLLayerDMPipelineScriptedCreator,
+            vtkMRMLMarkupsFiducialNode,
+        )
+        from vtk import reference as ref, vtkObject
+
+        class SoakPipeline(vtkMRMLLayerDMScriptedPipeline):
+            def __init__(self):
+                super().__init__()
+                # Not an interned small int : leaked call results show in its reference count
+                self.mouseCursor = 100000
+                self.nUpdates = 0
+
+            def CanProcessInteractionEvent(self, eventData):
+                return True, 0.0
+
+            def GetMouseCursor(self) -> int:
+                return self.mouseCursor
+
+            def OnUpdate(self, obj, eventId, callData) -> None:
+                self.nUpdates += 1
+
+            def ProcessInteractionEvent(self, eventData) -> bool:
+                return True
+
+        factory = vtkMRMLLayerDMPipelineFactory()
+        creator = vtkMRMLLayerDMPipelineScriptedCreator()
+        creator.SetPythonCallback(lambda _viewNode, _node: SoakPipeline())
+        factory.AddPipelineCreator(creator)
+
+        pipelineManager = vtkMRMLLayerDMPipelineManager()
+        pipelineManager.SetViewNode(slicer.mrmlScene.AddNewNodeByClass("vtkMRMLViewNode"))
+        pipelineManager.SetFactory(factory)
+        pipelineManager.SetRenderWindow(vtkRenderWindow())
+
+        node = vtkMRMLMarkupsFiducialNode()
+        assert pipelineManager.AddNode(node)
+        pipeline = pipelineManager.GetNodePipeline(node)
+        observed = vtkObject()
+        pipeline.UpdateObserver(None, observed)
+
+        eventData = vtkMRMLInteractionEventData()
+        distance = ref(0.0)
+
+        def dispatchEvents(nEvents):
+            for _ in range(nEvents // 4):
+                pipelineManager.CanProcessInteractionEvent(eventData, distance)
+                pipelineManager.ProcessInteractionEvent(eventData)
+                pipelineManager.GetMouseCursor()
+                observed.Modified()
+
+        # Warm up the cached python objects (bound methods, reused arguments)
+        dispatchEvents(100)
+        baselineReferences = vtkMRMLLayerDMScriptedPipeline.GetNumberOfLivePythonReferences()
+        baselineCursorRefCount = sys.getrefcount(pipeline.mouseCursor)
+        baselineEventRefCount = sys.getrefcount(eventData)
+
+        dispatchEvents(1000000)
+
+        assert pipeline.nUpdates == 250025
+        assert vtkMRMLLayerDMScriptedPipeline.GetNumberOfLivePythonReferences() == baselineReferences
+        assert sys.getrefcount(pipeline.mouseCursor) == baselineCursorRefCount
+        assert sys.getrefcount(eventData) == baselineEventRefCount